@@ -0,0 +1,115 @@
+#include "BorderppClock.hpp"
+#include "BorderppConfig.hpp"
+#include "BorderppCore.hpp"
+#include "BorderppStats.hpp"
+#include "borderDeco.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+
+static int onTimer(void* data) {
+    ((CBorderPPClock*)data)->tick();
+    return 0;
+}
+
+static int onAnimationTimer(void* data) {
+    ((CBorderPPClock*)data)->animationTick();
+    return 0;
+}
+
+CBorderPPClock::CBorderPPClock() {
+    m_pTimer          = wl_event_loop_add_timer(g_pCompositor->m_wlEventLoop, ::onTimer, this);
+    m_pAnimationTimer = wl_event_loop_add_timer(g_pCompositor->m_wlEventLoop, ::onAnimationTimer, this);
+    reload();
+}
+
+CBorderPPClock::~CBorderPPClock() {
+    if (m_pTimer)
+        wl_event_source_remove(m_pTimer);
+    if (m_pAnimationTimer)
+        wl_event_source_remove(m_pAnimationTimer);
+}
+
+void CBorderPPClock::registerDecoration(CBordersPlusPlus* deco) {
+    m_vDecorations.push_back(deco);
+}
+
+void CBorderPPClock::unregisterDecoration(CBordersPlusPlus* deco) {
+    std::erase(m_vDecorations, deco);
+}
+
+void CBorderPPClock::sample() {
+    const auto NOW  = std::chrono::system_clock::now();
+    const auto TIME = std::chrono::system_clock::to_time_t(NOW);
+    const auto FRAC = std::chrono::duration<double>(NOW - std::chrono::system_clock::from_time_t(TIME)).count();
+
+    std::tm    localTime;
+    localtime_r(&TIME, &localTime);
+
+    const double SECONDS = localTime.tm_hour * 3600.0 + localTime.tm_min * 60.0 + localTime.tm_sec + FRAC;
+
+    const auto   GROWTH = m_timeline.at(SECONDS);
+    m_fGrowth           = GROWTH.growth;
+    m_fSunset           = GROWTH.sunset;
+
+    // a little slack so the timer never fires just before the boundary
+    const int MS = std::max(1.0, std::ceil((GROWTH.next - SECONDS) * 1000.0) + 50);
+    wl_event_source_timer_update(m_pTimer, MS);
+}
+
+void CBorderPPClock::tick() {
+    g_borderPPCounters.growthWakeups.fetch_add(1, std::memory_order_relaxed);
+
+    sample();
+
+    for (auto const& deco : m_vDecorations) {
+        deco->onGrowthTick();
+    }
+}
+
+void CBorderPPClock::reload() {
+    m_timeline.build(g_pBorderPPConfig->get().vineKeyframes);
+    tick();
+    updateAnimation();
+}
+
+void CBorderPPClock::updateAnimation() {
+    const auto& CFG = g_pBorderPPConfig->get();
+
+    // 0 disarms the timer; the frames stop until animation is turned on again
+    wl_event_source_timer_update(m_pAnimationTimer, CFG.vines && CFG.vineAnimate ? 1 : 0);
+}
+
+void CBorderPPClock::animationTick() {
+    const auto& CFG = g_pBorderPPConfig->get();
+    if (!CFG.vines || !CFG.vineAnimate)
+        return;
+
+    // each monitor animates at the cap or its refresh rate, whichever is lower
+    const auto NOW = std::chrono::steady_clock::now();
+    m_vDueMonitors.clear();
+
+    for (auto const& m : g_pCompositor->m_monitors) {
+        const double FPS   = std::min<double>(CFG.vineAnimationFps, m->m_refreshRate > 0 ? m->m_refreshRate : CFG.vineAnimationFps);
+        auto&        last  = m_mLastAnimationFrame[m->m_id];
+        // a little slack so timer jitter doesn't skip every other frame
+        const auto   FRAME = std::chrono::duration<double>(0.9 / FPS);
+
+        if (NOW - last >= FRAME) {
+            last = NOW;
+            m_vDueMonitors.push_back(m->m_id);
+        }
+    }
+
+    if (!m_vDueMonitors.empty()) {
+        for (auto const& deco : m_vDecorations) {
+            deco->onAnimationTick(m_vDueMonitors);
+        }
+    }
+
+    wl_event_source_timer_update(m_pAnimationTimer, std::max(1, 1000 / CFG.vineAnimationFps));
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/plugins/PluginAPI.hpp>
+#include <wayland-server-core.h>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include "BorderppCore.hpp"
+
+class CBordersPlusPlus;
+
+// Plugin-global source of the time of day for vine growth.
+// Samples the local time only when a visible step is due, looks growth and tint
+// up in the vine_keyframes timeline, arms a single event loop timer for the next
+// step and damages the decorations that changed. Decorations only ever read the
+// sampled values. With vine_animate it also paces the animation frames, capped
+// per monitor.
+class CBorderPPClock {
+  public:
+    CBorderPPClock();
+    ~CBorderPPClock();
+
+    // Growth progress in 1% steps, 0 at midnight and 1 from 17:00 by default
+    float growth() const {
+        return m_fGrowth;
+    }
+
+    // Blend towards the sunset tint in 1% steps, 0 during the day and 1 from 17:30 by default
+    float sunset() const {
+        return m_fSunset;
+    }
+
+    void registerDecoration(CBordersPlusPlus* deco);
+    void unregisterDecoration(CBordersPlusPlus* deco);
+
+    // Samples the time, arms the timer for the next step and notifies decorations
+    void tick();
+
+    // Rebuilds the timeline from the config and samples it again, call after reloads
+    void reload();
+
+    // Starts or stops the animation frames for the current config
+    void updateAnimation();
+
+    // Damages the animated vines on every monitor that is due for a frame
+    void animationTick();
+
+  private:
+    void                           sample();
+
+    float                          m_fGrowth = 0.F;
+    float                          m_fSunset = 0.F;
+    CBorderPPVineTimeline          m_timeline;
+
+    wl_event_source*               m_pTimer          = nullptr;
+    wl_event_source*               m_pAnimationTimer = nullptr;
+    std::vector<CBordersPlusPlus*> m_vDecorations;
+
+    // last animation frame per monitor, and the monitors due this tick
+    std::unordered_map<MONITORID, std::chrono::steady_clock::time_point> m_mLastAnimationFrame;
+    std::vector<MONITORID>         m_vDueMonitors;
+};
+
+inline UP<CBorderPPClock> g_pBorderPPClock;
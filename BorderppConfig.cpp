@@ -0,0 +1,75 @@
+#include "BorderppConfig.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/config/ConfigManager.hpp>
+#include <algorithm>
+
+static Hyprlang::INT* const* intPtr(const std::string& name) {
+    return (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, name)->getDataStaticPtr();
+}
+
+static Hyprlang::STRING const* stringPtr(const std::string& name) {
+    return (Hyprlang::STRING const*)HyprlandAPI::getConfigValue(PHANDLE, name)->getDataStaticPtr();
+}
+
+CBorderPPConfig::CBorderPPConfig() {
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:add_borders", Hyprlang::INT{1});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:natural_rounding", Hyprlang::INT{1});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:enable_vines", Hyprlang::INT{1});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:vine_thickness", Hyprlang::INT{2});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:cache_vines", Hyprlang::INT{0});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:vine_primitive_budget", Hyprlang::INT{VINE_DEFAULT_PRIMITIVE_BUDGET});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:vine_animate", Hyprlang::INT{0});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:vine_animation_fps", Hyprlang::INT{30});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:vine_keyframes", Hyprlang::STRING{""});
+
+    for (size_t i = 0; i < MAX_BORDERS; ++i) {
+        HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:col.border_" + std::to_string(i + 1), Hyprlang::INT{*configStringToInt("rgba(000000ee)")});
+        HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:border_size_" + std::to_string(i + 1), Hyprlang::INT{-1});
+    }
+
+    m_values.borders          = intPtr("plugin:borders-plus-plus:add_borders");
+    m_values.naturalRounding  = intPtr("plugin:borders-plus-plus:natural_rounding");
+    m_values.borderSize       = intPtr("general:border_size");
+    m_values.vines            = intPtr("plugin:borders-plus-plus:enable_vines");
+    m_values.vineThickness    = intPtr("plugin:borders-plus-plus:vine_thickness");
+    m_values.cacheVines       = intPtr("plugin:borders-plus-plus:cache_vines");
+    m_values.vineBudget       = intPtr("plugin:borders-plus-plus:vine_primitive_budget");
+    m_values.vineAnimate      = intPtr("plugin:borders-plus-plus:vine_animate");
+    m_values.vineAnimationFps = intPtr("plugin:borders-plus-plus:vine_animation_fps");
+    m_values.vineKeyframes    = stringPtr("plugin:borders-plus-plus:vine_keyframes");
+
+    for (size_t i = 0; i < MAX_BORDERS; ++i) {
+        m_values.colors[i] = intPtr("plugin:borders-plus-plus:col.border_" + std::to_string(i + 1));
+        m_values.sizes[i]  = intPtr("plugin:borders-plus-plus:border_size_" + std::to_string(i + 1));
+    }
+}
+
+void CBorderPPConfig::reload() {
+    const auto GENERATION = m_snapshot.generation;
+
+    m_snapshot                  = {};
+    m_snapshot.generation       = GENERATION + 1;
+    m_snapshot.borders          = std::clamp<Hyprlang::INT>(**m_values.borders, 0, MAX_BORDERS);
+    m_snapshot.borderSize       = **m_values.borderSize;
+    m_snapshot.naturalRounding  = **m_values.naturalRounding;
+    m_snapshot.vines            = **m_values.vines;
+    m_snapshot.vineThickness    = **m_values.vineThickness > 0 ? **m_values.vineThickness : 2;
+    m_snapshot.cacheVines       = **m_values.cacheVines;
+    m_snapshot.vineBudget       = std::max<Hyprlang::INT>(**m_values.vineBudget, 0);
+    m_snapshot.vineAnimate      = **m_values.vineAnimate;
+    m_snapshot.vineAnimationFps = std::clamp<Hyprlang::INT>(**m_values.vineAnimationFps, 1, 1000);
+
+    // empty or malformed keeps the default timeline
+    if (!parseVineKeyframes(*m_values.vineKeyframes ? *m_values.vineKeyframes : "", m_snapshot.vineKeyframes))
+        m_snapshot.vineKeyframes.assign(VINE_DEFAULT_KEYFRAMES.begin(), VINE_DEFAULT_KEYFRAMES.end());
+
+    for (size_t i = 0; i < MAX_BORDERS; ++i) {
+        m_snapshot.sizes[i]  = **m_values.sizes[i] == -1 ? m_snapshot.borderSize : **m_values.sizes[i];
+        const CHyprColor COLOR = CHyprColor{(uint64_t)**m_values.colors[i]};
+        m_snapshot.colors[i]   = {(float)COLOR.r, (float)COLOR.g, (float)COLOR.b, (float)COLOR.a};
+
+        if (i < m_snapshot.borders)
+            m_snapshot.totalThickness += m_snapshot.sizes[i];
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/plugins/PluginAPI.hpp>
+#include <array>
+#include <vector>
+
+#include "BorderppCore.hpp"
+#include "BorderppVines.hpp"
+
+// Everything the draw path needs from the config, resolved once per reload.
+struct SBorderPPConfig {
+    size_t                                  borders = 0; // add_borders, clamped to [0, MAX_BORDERS]
+    std::array<int, MAX_BORDERS>            sizes   = {}; // -1 already mapped to general:border_size
+    std::array<SBorderPPColor, MAX_BORDERS> colors;
+    double                                  totalThickness  = 0; // sum of the active border sizes
+    int                                     borderSize      = 0; // general:border_size
+    bool                                    naturalRounding = true;
+
+    bool                                    vines            = true;
+    int                                     vineThickness    = 2;
+    bool                                    cacheVines       = false;
+    size_t                                  vineBudget       = VINE_DEFAULT_PRIMITIVE_BUDGET; // triangles per decoration, 0 for no limit
+    bool                                    vineAnimate      = false;
+    int                                     vineAnimationFps = 30; // cap per monitor, at least 1
+    std::vector<SVineKeyframe>              vineKeyframes;          // sorted, the default if vine_keyframes is invalid
+
+    // bumped on every reload so decorations can drop derived state
+    uint64_t generation = 0;
+};
+
+class CBorderPPConfig {
+  public:
+    // Registers the config values and resolves their pointers
+    CBorderPPConfig();
+
+    // Rebuilds the snapshot, call on configReloaded
+    void                   reload();
+
+    const SBorderPPConfig& get() const {
+        return m_snapshot;
+    }
+
+  private:
+    struct {
+        Hyprlang::INT* const*                          borders          = nullptr;
+        Hyprlang::INT* const*                          naturalRounding  = nullptr;
+        Hyprlang::INT* const*                          borderSize       = nullptr;
+        Hyprlang::INT* const*                          vines            = nullptr;
+        Hyprlang::INT* const*                          vineThickness    = nullptr;
+        Hyprlang::INT* const*                          cacheVines       = nullptr;
+        Hyprlang::INT* const*                          vineBudget       = nullptr;
+        Hyprlang::INT* const*                          vineAnimate      = nullptr;
+        Hyprlang::INT* const*                          vineAnimationFps = nullptr;
+        Hyprlang::STRING const*                        vineKeyframes    = nullptr;
+        std::array<Hyprlang::INT* const*, MAX_BORDERS> sizes            = {};
+        std::array<Hyprlang::INT* const*, MAX_BORDERS> colors           = {};
+    } m_values;
+
+    SBorderPPConfig m_snapshot;
+};
+
+inline UP<CBorderPPConfig> g_pBorderPPConfig;
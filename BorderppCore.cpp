@@ -0,0 +1,198 @@
+#include "BorderppCore.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+
+constexpr double SECONDS_PER_DAY = 24 * 3600;
+// growth and tint are published in 1% steps, so decorations only change every few minutes
+constexpr float  STEPS = 100.F;
+
+size_t layoutBorderRings(const SBorderRingLayout& layout, const SBorderPPRect& innerBox, std::array<SBorderRing, MAX_BORDERS>& out) {
+    const double ORIGINALROUND = layout.rounding;
+
+    SBorderPPRect box        = innerBox;
+    double        rounding   = layout.rounding;
+    double        ringOffset = 0;
+    size_t        count      = 0;
+
+    for (size_t i = 0; i < std::min({layout.borders, layout.sizes.size(), layout.colors.size(), MAX_BORDERS}); ++i) {
+        const int    PREVBORDERSIZESCALED = i == 0 ? 0 : layout.sizes[i - 1] * layout.scale;
+        const double THISBORDERSIZESCALED = std::round(layout.sizes[i] * layout.scale);
+
+        if (i != 0) {
+            rounding += rounding == 0 ? 0 : PREVBORDERSIZESCALED;
+            ringOffset += PREVBORDERSIZESCALED;
+            box = box.expanded(PREVBORDERSIZESCALED);
+        }
+
+        if (box.w < 1 || box.h < 1)
+            break;
+
+        out[count++] = {
+            .inner      = (float)ringOffset,
+            .outer      = (float)(ringOffset + THISBORDERSIZESCALED),
+            .innerRound = (float)(layout.naturalRounding ? ORIGINALROUND : rounding),
+            .outerRound = (float)(layout.naturalRounding ? ORIGINALROUND : (rounding == 0 ? 0 : rounding + THISBORDERSIZESCALED)),
+            .color      = layout.colors[i],
+        };
+    }
+
+    return count;
+}
+
+static std::string_view trim(std::string_view str) {
+    while (!str.empty() && std::isspace((unsigned char)str.front()))
+        str.remove_prefix(1);
+    while (!str.empty() && std::isspace((unsigned char)str.back()))
+        str.remove_suffix(1);
+    return str;
+}
+
+bool parseVineKeyframes(std::string_view str, std::vector<SVineKeyframe>& out) {
+    std::vector<SVineKeyframe> keyframes;
+
+    while (!trim(str).empty()) {
+        const auto       COMMA = str.find(',');
+        std::string_view entry = trim(str.substr(0, COMMA));
+        str                    = COMMA == std::string_view::npos ? std::string_view{} : str.substr(COMMA + 1);
+
+        // HH:MM growth sunset
+        int   hour = 0, minute = 0;
+        float growth = 0, sunset = 0;
+        auto  end = entry.data() + entry.size();
+        auto  r   = std::from_chars(entry.data(), end, hour);
+        if (r.ec != std::errc{} || r.ptr == end || *r.ptr != ':')
+            return false;
+        r = std::from_chars(r.ptr + 1, end, minute);
+        if (r.ec != std::errc{})
+            return false;
+
+        entry = trim({r.ptr, end});
+        r     = std::from_chars(entry.data(), entry.data() + entry.size(), growth);
+        if (r.ec != std::errc{})
+            return false;
+
+        entry = trim({r.ptr, entry.data() + entry.size()});
+        r     = std::from_chars(entry.data(), entry.data() + entry.size(), sunset);
+        if (r.ec != std::errc{} || !trim({r.ptr, entry.data() + entry.size()}).empty())
+            return false;
+
+        if (hour < 0 || hour > 24 || minute < 0 || minute >= 60 || hour * 60 + minute > (int)VINE_DAY_MINUTES)
+            return false;
+
+        keyframes.push_back({.minute = hour * 60.0 + minute, .growth = std::clamp(growth, 0.F, 1.F), .sunset = std::clamp(sunset, 0.F, 1.F)});
+    }
+
+    if (keyframes.empty())
+        return false;
+
+    std::ranges::stable_sort(keyframes, {}, &SVineKeyframe::minute);
+    out = std::move(keyframes);
+    return true;
+}
+
+CBorderPPVineTimeline::CBorderPPVineTimeline() {
+    build(VINE_DEFAULT_KEYFRAMES);
+}
+
+void CBorderPPVineTimeline::build(std::span<const SVineKeyframe> keyframes) {
+    size_t next = 0;
+
+    for (size_t m = 0; m <= VINE_DAY_MINUTES; ++m) {
+        while (next < keyframes.size() && keyframes[next].minute <= m)
+            next++;
+
+        if (next == 0) {
+            m_entries[m] = {keyframes.front().growth, keyframes.front().sunset};
+        } else if (next == keyframes.size()) {
+            m_entries[m] = {keyframes.back().growth, keyframes.back().sunset};
+        } else {
+            const auto& A = keyframes[next - 1];
+            const auto& B = keyframes[next];
+            const float T = (float)((m - A.minute) / (B.minute - A.minute));
+            m_entries[m]  = {std::lerp(A.growth, B.growth, T), std::lerp(A.sunset, B.sunset, T)};
+        }
+    }
+}
+
+// keeps interpolated values such as 1.0 from landing on the step below
+constexpr float STEP_EPSILON = 1e-4F;
+
+// The 1% step a value is on
+static float quantize(float v) {
+    return std::floor(v * STEPS + STEP_EPSILON) / STEPS;
+}
+
+// When a value going from v0 to v1 over [t0, t1] leaves the step it is on at t0, if it does
+static double stepCrossing(float v0, float v1, double t0, double t1) {
+    const float STEP = quantize(v0);
+    if (quantize(v1) == STEP)
+        return -1;
+
+    // going down it leaves once below the step, going up once it reaches the next one
+    const float BOUNDARY = (v1 > v0 ? STEP + 1.F / STEPS : STEP) - STEP_EPSILON / STEPS;
+    return t0 + (t1 - t0) * std::clamp((double)(BOUNDARY - v0) / (v1 - v0), 0.0, 1.0);
+}
+
+SVineGrowth CBorderPPVineTimeline::at(double secondsSinceMidnight) const {
+    const double SECONDS = std::clamp(secondsSinceMidnight, 0.0, SECONDS_PER_DAY);
+    const size_t MINUTE  = std::min((size_t)(SECONDS / 60.0), VINE_DAY_MINUTES - 1);
+    const float  T       = (float)(SECONDS / 60.0 - MINUTE);
+
+    const auto&  A      = m_entries[MINUTE];
+    const auto&  B      = m_entries[MINUTE + 1];
+    const float  GROWTH = std::lerp(A.growth, B.growth, T);
+    const float  SUNSET = std::lerp(A.sunset, B.sunset, T);
+
+    // the next time either value reaches another step, straight lines between entries;
+    // past the last entry the day wraps and midnight is sampled again
+    double       next = SECONDS_PER_DAY;
+    float        g0 = GROWTH, s0 = SUNSET;
+    double       t0 = SECONDS;
+    for (size_t m = MINUTE + 1; m <= VINE_DAY_MINUTES; ++m) {
+        const double T1 = m * 60.0;
+        const double G  = stepCrossing(g0, m_entries[m].growth, t0, T1);
+        const double S  = stepCrossing(s0, m_entries[m].sunset, t0, T1);
+
+        if (G >= 0 || S >= 0) {
+            next = std::min(G >= 0 ? G : T1, S >= 0 ? S : T1);
+            break;
+        }
+
+        g0 = m_entries[m].growth;
+        s0 = m_entries[m].sunset;
+        t0 = T1;
+    }
+
+    return {.growth = quantize(GROWTH), .sunset = quantize(SUNSET), .next = next};
+}
+
+SVineGrowth vineGrowthAt(double secondsSinceMidnight) {
+    static const CBorderPPVineTimeline DEFAULT;
+    return DEFAULT.at(secondsSinceMidnight);
+}
+
+float vineAnimationTime(double seconds) {
+    return (float)std::fmod(seconds, VINE_ANIMATION_PERIOD);
+}
+
+SBorderPPColor vineColorFor(const SBorderPPColor& base, float sunset) {
+    // green color during the day
+    const float DAYR = std::min(base.r * 0.5F + 0.2F, 1.F);
+    const float DAYG = std::min(base.g * 1.2F, 1.F);
+    const float DAYB = std::min(base.b * 0.5F, 1.F);
+
+    // orange sunset color
+    const float SUNSETR = std::min(base.r * 1.5F + 0.3F, 1.F);
+    const float SUNSETG = std::min(base.g * 0.8F + 0.2F, 1.F);
+    const float SUNSETB = std::min(base.b * 0.3F, 1.F);
+
+    SBorderPPColor color = base;
+    color.r              = std::lerp(DAYR, SUNSETR, sunset);
+    color.g              = std::lerp(DAYG, SUNSETG, sunset);
+    color.b              = std::lerp(DAYB, SUNSETB, sunset);
+
+    return color;
+}
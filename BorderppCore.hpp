@@ -0,0 +1,187 @@
+#pragma once
+
+// Compositor-independent part of the plugin: border ring layout, growth
+// scheduling and the primitives the decorations emit. Nothing in here may
+// include Hyprland, so it can be built and measured on its own (see bench/).
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <string_view>
+#include <vector>
+
+constexpr size_t MAX_BORDERS = 9;
+
+// Leaves stick out of the stems by up to this many times vine_thickness
+constexpr double VINE_LEAF_MARGIN = 6.0;
+
+// Vine animation runs on the GPU from a time that wraps every period; the speeds
+// are whole cycles per period so the wrap doesn't jump
+constexpr double VINE_ANIMATION_PERIOD = 3600.0;                                             // seconds
+constexpr float  VINE_SWAY_SPEED       = 2.F * std::numbers::pi_v<float> * 1800.F / 3600.F; // stems, 0.5 Hz
+constexpr float  VINE_LEAF_SPIN_SPEED  = 2.F * std::numbers::pi_v<float> * 115.F / 3600.F;  // leaves, ~0.2 rad/s
+
+struct SBorderPPRect {
+    double x = 0, y = 0, w = 0, h = 0;
+
+    bool   empty() const {
+        return w <= 0 || h <= 0;
+    }
+
+    SBorderPPRect expanded(double by) const {
+        return {x - by, y - by, w + by * 2, h + by * 2};
+    }
+
+    bool intersects(const SBorderPPRect& other) const {
+        return x < other.x + other.w && x + w > other.x && y < other.y + other.h && y + h > other.y;
+    }
+
+    bool contains(const SBorderPPRect& other) const {
+        return other.x >= x && other.y >= y && other.x + other.w <= x + w && other.y + other.h <= y + h;
+    }
+
+    bool operator==(const SBorderPPRect&) const = default;
+};
+
+// A viewport that culls nothing, e.g. for offscreen targets that must hold everything
+constexpr SBorderPPRect UNBOUNDED_VIEWPORT = {-1e9, -1e9, 2e9, 2e9};
+
+// Straight (not premultiplied) color, like CHyprColor
+struct SBorderPPColor {
+    float r = 0, g = 0, b = 0, a = 0;
+
+    bool  operator==(const SBorderPPColor&) const = default;
+};
+
+// Interleaved vertex of a tessellated vine stem.
+// across/along are the fragment's offset from the stem centerline in pixels,
+// along is only non-zero on the rounded end caps. The vertex is drawn moved by
+// sway * sin(swayPhase + time * VINE_SWAY_SPEED), so animating needs no new geometry.
+struct SStemVertex {
+    float x = 0, y = 0;
+    float across = 0, along = 0;
+    float swayX = 0, swayY = 0, swayPhase = 0;
+};
+
+// One leaf, drawn as an instance of a single leaf shape hanging from its stem
+// below (x, y). Like the stems it is drawn moved by the sway, and rotated by
+// 0.3 * sin(spin + time * VINE_LEAF_SPIN_SPEED) radians
+struct SLeafInstance {
+    float          x = 0, y = 0;
+    float          size = 0;
+    float          spin = 0;
+    float          swayX = 0, swayY = 0, swayPhase = 0;
+    float          pad   = 0;
+    SBorderPPColor color;
+};
+
+// One concentric border ring, in pixels relative to the innermost box.
+struct SBorderRing {
+    float          inner      = 0; // distance of the ring's inner edge from the innermost box
+    float          outer      = 0; // distance of the ring's outer edge
+    float          innerRound = 0;
+    float          outerRound = 0;
+    SBorderPPColor color;
+};
+
+// Everything the core draws goes through this. The plugin implements it with
+// OpenGL on top of Hyprland's render state, the benchmark just records calls.
+// All coordinates are in pixels of the current render target.
+class IBorderPPRenderer {
+  public:
+    virtual ~IBorderPPRenderer() = default;
+
+    // Draws all rings around box (the innermost, window-sized box)
+    virtual void          drawRings(const SBorderPPRect& box, std::span<const SBorderRing> rings, float roundingPower, float a) = 0;
+
+    // Draws a batch of stem strips, bounds is the batch's bounding box including the sway.
+    // time is the animation time, see vineAnimationTime()
+    virtual void          drawStems(std::span<const SStemVertex> verts, const SBorderPPRect& bounds, const SBorderPPColor& col, float radius, float time) = 0;
+
+    // Draws a batch of leaves, bounds is the batch's bounding box including the sway
+    virtual void          drawLeaves(std::span<const SLeafInstance> leaves, const SBorderPPRect& bounds, float time) = 0;
+
+    // True if the current damage touches the band between outer and inner
+    // Pass an empty inner rect to test the whole of outer
+    virtual bool          isDamaged(const SBorderPPRect& outer, const SBorderPPRect& inner = {}) = 0;
+
+    // The part of the render target that reaches the screen, e.g. the current
+    // monitor; geometry outside it is culled before it is issued
+    virtual SBorderPPRect viewport() = 0;
+};
+
+// What the ring layout needs from the config and the window
+struct SBorderRingLayout {
+    size_t                          borders = 0; // entries used from sizes and colors
+    std::span<const int>            sizes;
+    std::span<const SBorderPPColor> colors;
+    double                          scale           = 1.0;
+    double                          rounding        = 0; // window rounding + border_size, in pixels, 0 for none
+    bool                            naturalRounding = true;
+};
+
+// Lays out the rings around innerBox, returns how many were written to out
+size_t layoutBorderRings(const SBorderRingLayout& layout, const SBorderPPRect& innerBox, std::array<SBorderRing, MAX_BORDERS>& out);
+
+// Entries of the day's timeline, one per minute plus midnight again to interpolate towards
+constexpr size_t VINE_DAY_MINUTES = 24 * 60;
+
+// One point of the vine_keyframes timeline; values in between are interpolated
+struct SVineKeyframe {
+    double minute = 0; // since midnight
+    float  growth = 0; // 0 a sprout, 1 full coverage
+    float  sunset = 0; // 0 daytime green, 1 sunset orange
+};
+
+// The vine_keyframes default: growth from midnight to full at 17:00, and the sunset
+// tint blending in between 16:30 and 17:30
+inline constexpr std::array<SVineKeyframe, 4> VINE_DEFAULT_KEYFRAMES = {{
+    {.minute = 0, .growth = 0.F, .sunset = 0.F},
+    {.minute = 16.5 * 60, .growth = 16.5F / 17.F, .sunset = 0.F},
+    {.minute = 17 * 60, .growth = 1.F, .sunset = 0.5F},
+    {.minute = 17.5 * 60, .growth = 1.F, .sunset = 1.F},
+}};
+
+// Parses vine_keyframes, "HH:MM growth sunset" entries separated by commas, into out
+// sorted by time. False (and out untouched) if any entry is malformed
+bool parseVineKeyframes(std::string_view str, std::vector<SVineKeyframe>& out);
+
+// Vine growth for a time of day, see GROWTH_TIMELINE.md
+struct SVineGrowth {
+    float  growth = 0; // 0 at midnight, 1 for full coverage, in 1% steps
+    float  sunset = 0; // blend from the day tint to the sunset tint, in 1% steps
+    double next   = 0; // seconds since midnight at which the growth or color changes next
+};
+
+// The day's growth and tint sampled once a minute from the keyframes, so looking a time
+// up is a table read and an interpolation. Rebuilt when the keyframes change
+class CBorderPPVineTimeline {
+  public:
+    // Builds the default timeline
+    CBorderPPVineTimeline();
+
+    // Resamples keyframes (sorted by time, at least one); before the first and after
+    // the last one their values hold
+    void        build(std::span<const SVineKeyframe> keyframes);
+
+    SVineGrowth at(double secondsSinceMidnight) const;
+
+  private:
+    struct SEntry {
+        float growth = 0;
+        float sunset = 0;
+    };
+
+    std::array<SEntry, VINE_DAY_MINUTES + 1> m_entries;
+};
+
+// Growth for a time of day on the default timeline
+SVineGrowth    vineGrowthAt(double secondsSinceMidnight);
+
+// Animation time for a monotonic clock reading, wrapped to VINE_ANIMATION_PERIOD
+float          vineAnimationTime(double seconds);
+
+// Vine tint for a base color: green during the day, orange at sunset, blended by sunset
+SBorderPPColor vineColorFor(const SBorderPPColor& base, float sunset);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for temporaries that only live until the end of a frame.
+// Allocations are a pointer bump into one block; reset() frees them all at once.
+// A frame that doesn't fit spills into extra blocks, and the next reset() grows
+// the main block to fit it, so steady state frames never touch the heap.
+class CBorderPPFrameArena {
+  public:
+    // Storage for n default-initialized Ts, valid until reset()
+    template <typename T>
+    std::span<T> alloc(size_t n) {
+        static_assert(std::is_trivially_destructible_v<T>, "the arena never runs destructors");
+        return {new (allocBytes(n * sizeof(T), alignof(T))) T[n], n};
+    }
+
+    void reset() {
+        if (!m_vSpill.empty()) {
+            m_iCapacity = std::max(m_iCapacity * 2, m_iUsed);
+            m_block     = std::make_unique<std::byte[]>(m_iCapacity);
+            m_vSpill.clear();
+        }
+
+        m_iUsed = 0;
+    }
+
+    size_t capacity() const {
+        return m_iCapacity;
+    }
+
+  private:
+    void* allocBytes(size_t size, size_t align) {
+        const size_t START = (m_iUsed + align - 1) & ~(align - 1);
+
+        // keeps counting past the block, so reset() knows how much the frame needed
+        m_iUsed = START + size;
+
+        if (!m_block) {
+            m_iCapacity = std::max(INITIAL_CAPACITY, m_iUsed);
+            m_block     = std::make_unique<std::byte[]>(m_iCapacity);
+        }
+
+        if (m_iUsed <= m_iCapacity)
+            return m_block.get() + START;
+
+        // out of room this frame; earlier allocations must stay valid, so don't move the block
+        return m_vSpill.emplace_back(std::make_unique<std::byte[]>(size)).get();
+    }
+
+    static constexpr size_t                   INITIAL_CAPACITY = 16 * 1024;
+
+    std::unique_ptr<std::byte[]>              m_block;
+    size_t                                    m_iCapacity = 0;
+    size_t                                    m_iUsed     = 0;
+    std::vector<std::unique_ptr<std::byte[]>> m_vSpill;
+};
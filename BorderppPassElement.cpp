@@ -1,13 +1,38 @@
 #include "BorderppPassElement.hpp"
 #include <hyprland/src/render/OpenGL.hpp>
 #include "borderDeco.hpp"
+#include "BorderppTrace.hpp"
+
+#include <chrono>
 
 CBorderPPPassElement::CBorderPPPassElement(const CBorderPPPassElement::SBorderPPData& data_) : data(data_) {
     ;
 }
 
 void CBorderPPPassElement::draw(const CRegion& damage) {
-    data.deco->drawPass(g_pHyprOpenGL->m_renderData.pMonitor.lock(), data.a);
+    BPP_TRACE_ZONE("CBorderPPPassElement::draw");
+
+    // the renderer is created by the first pass that draws something
+    const auto START  = std::chrono::steady_clock::now();
+    const auto BEFORE = g_pBorderPPRenderer ? g_pBorderPPRenderer->m_issued : CBorderPPRenderer::SIssued{};
+
+    data.deco->drawPass(g_pHyprOpenGL->m_renderData.pMonitor.lock(), data.a, damage);
+
+    auto&      counters = data.deco->m_counters;
+    counters.addPass(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - START).count());
+
+    if (g_pBorderPPRenderer) {
+        counters.add(&SBorderPPCounters::drawCalls, g_pBorderPPRenderer->m_issued.drawCalls - BEFORE.drawCalls);
+        counters.add(&SBorderPPCounters::primitives, g_pBorderPPRenderer->m_issued.triangles - BEFORE.triangles);
+    }
+}
+
+std::optional<CBox> CBorderPPPassElement::boundingBox() {
+    const auto PMONITOR = g_pHyprOpenGL->m_renderData.pMonitor.lock();
+    if (!PMONITOR)
+        return std::nullopt;
+
+    return data.deco->getDrawBounds(PMONITOR);
 }
 
 bool CBorderPPPassElement::needsLiveBlur() {
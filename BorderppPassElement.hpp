@@ -13,11 +13,12 @@ class CBorderPPPassElement : public IPassElement {
     CBorderPPPassElement(const SBorderPPData& data_);
     virtual ~CBorderPPPassElement() = default;
 
-    virtual void        draw(const CRegion& damage);
-    virtual bool        needsLiveBlur();
-    virtual bool        needsPrecomputeBlur();
+    virtual void                draw(const CRegion& damage);
+    virtual std::optional<CBox> boundingBox();
+    virtual bool                needsLiveBlur();
+    virtual bool                needsPrecomputeBlur();
 
-    virtual const char* passName() {
+    virtual const char*         passName() {
         return "CBorderPPPassElement";
     }
 
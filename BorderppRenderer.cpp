@@ -0,0 +1,597 @@
+#include "BorderppRenderer.hpp"
+
+#include <hyprland/src/debug/Log.hpp>
+#include <algorithm>
+#include <cmath>
+
+// The sway moves whole cross sections of the stem, so its width and the
+// capsule SDF below don't change while it animates
+static const char* STEMVERTSRC = R"#(#version 300 es
+uniform mat3 proj;
+uniform float time;
+uniform float swaySpeed;
+in vec2 pos;
+in vec2 offset;
+in vec3 sway;
+out vec2 v_offset;
+
+void main() {
+    vec2 swayed = pos + sway.xy * sin(sway.z + time * swaySpeed);
+
+    gl_Position = vec4(proj * vec3(swayed, 1.0), 1.0);
+    v_offset    = offset;
+}
+)#";
+
+// Capsule SDF: distance from the centerline is |offset|, so the strip body
+// gets an antialiased edge and the end caps come out round.
+// pass 1 keeps only the fully covered core, pass 2 only the antialiased edge
+static const char* STEMFRAGSRC = R"#(#version 300 es
+precision highp float;
+uniform vec4 color;
+uniform float radius;
+uniform int pass;
+in vec2 v_offset;
+layout(location = 0) out vec4 fragColor;
+
+void main() {
+    float coverage = clamp(radius + 0.5 - length(v_offset), 0.0, 1.0);
+    bool  core     = coverage >= 0.999;
+    if (coverage <= 0.0 || (pass == 1 && !core) || (pass == 2 && core))
+        discard;
+
+    fragColor = color * coverage;
+}
+)#";
+
+static const char* QUADVERTSRC = R"#(#version 300 es
+uniform mat3 proj;
+uniform vec2 fullSize;
+in vec2 pos;
+out vec2 v_pos;
+
+void main() {
+    gl_Position = vec4(proj * vec3(pos, 1.0), 1.0);
+    v_pos       = (pos - 0.5) * fullSize;
+}
+)#";
+
+// All concentric rings in one pass: each ring is the area between two rounded
+// boxes grown from the innermost box, rounded with Hyprland's rounding power.
+static const char* RINGFRAGSRC = R"#(#version 300 es
+precision highp float;
+uniform vec2 halfSize;
+uniform vec4 colors[9];
+uniform vec4 rings[9]; // inner, outer, inner radius, outer radius
+uniform int ringCount;
+uniform float roundingPower;
+uniform float alpha;
+in vec2 v_pos;
+layout(location = 0) out vec4 fragColor;
+
+float roundedBoxSDF(vec2 p, vec2 size, float radius) {
+    radius      = min(radius, min(size.x, size.y));
+    vec2 q      = abs(p) - size + radius;
+    vec2 corner = max(q, 0.0);
+    float dist  = radius > 0.0 ? pow(pow(corner.x, roundingPower) + pow(corner.y, roundingPower), 1.0 / roundingPower) : max(corner.x, corner.y);
+    return dist + min(max(q.x, q.y), 0.0) - radius;
+}
+
+void main() {
+    vec4 color = vec4(0.0);
+
+    for (int i = 0; i < ringCount; ++i) {
+        float inner    = roundedBoxSDF(v_pos, halfSize + rings[i].x, rings[i].z);
+        float outer    = roundedBoxSDF(v_pos, halfSize + rings[i].y, rings[i].w);
+        float coverage = clamp(0.5 - outer, 0.0, 1.0) * clamp(0.5 + inner, 0.0, 1.0);
+        color += colors[i] * coverage;
+    }
+
+    if (color.a <= 0.0)
+        discard;
+
+    fragColor = color * alpha;
+}
+)#";
+
+// One quad per leaf instance, swayed with its stem and rotated about its anchor
+static const char* LEAFVERTSRC = R"#(#version 300 es
+uniform mat3 proj;
+uniform float time;
+uniform float swaySpeed;
+uniform float spinSpeed;
+in vec2 corner;
+in vec2 center;
+in vec2 sizeSpin;
+in vec3 sway;
+in vec4 color;
+out vec2 v_leaf;
+out float v_size;
+out vec4 v_color;
+
+void main() {
+    vec2 local     = (corner * 2.0 - 1.0) * 0.8;
+    float rotation = 0.3 * sin(sizeSpin.y + time * spinSpeed);
+    float c        = cos(rotation);
+    float s        = sin(rotation);
+    vec2 anchor    = center + sway.xy * sin(sway.z + time * swaySpeed);
+    vec2 pos       = anchor + mat2(c, s, -s, c) * local * sizeSpin.x;
+
+    gl_Position = vec4(proj * vec3(pos, 1.0), 1.0);
+    v_leaf      = local;
+    v_size      = sizeSpin.x;
+    v_color     = vec4(color.rgb * color.a, color.a);
+}
+)#";
+
+// Leaf SDF in units of the leaf size: a pointed body (two intersecting circles)
+// and a short stem hanging below it, darker than the body
+static const char* LEAFFRAGSRC = R"#(#version 300 es
+precision highp float;
+in vec2 v_leaf;
+in float v_size;
+in vec4 v_color;
+layout(location = 0) out vec4 fragColor;
+
+float vesicaSDF(vec2 p, float r, float d) {
+    p       = abs(p);
+    float b = sqrt(r * r - d * d);
+    return (p.y - b) * d > p.x * b ? length(p - vec2(0.0, b)) : length(p - vec2(-d, 0.0)) - r;
+}
+
+float segmentSDF(vec2 p, vec2 a, vec2 b, float r) {
+    vec2 pa = p - a, ba = b - a;
+    float h = clamp(dot(pa, ba) / dot(ba, ba), 0.0, 1.0);
+    return length(pa - ba * h) - r;
+}
+
+void main() {
+    float body = vesicaSDF(v_leaf, 0.55, 0.25);
+    float stem = segmentSDF(v_leaf, vec2(0.0, 0.4), vec2(0.0, 0.75), 0.06);
+
+    float coverage = clamp(0.5 - min(body, stem) * v_size, 0.0, 1.0);
+    if (coverage <= 0.0)
+        discard;
+
+    vec3 tint = body <= stem ? vec3(1.0) : vec3(0.7, 0.8, 0.7);
+    fragColor = vec4(v_color.rgb * tint, v_color.a) * coverage;
+}
+)#";
+
+static GLuint compileShader(GLenum type, const char* src) {
+    auto shader = glCreateShader(type);
+
+    glShaderSource(shader, 1, &src, nullptr);
+    glCompileShader(shader);
+
+    GLint ok = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (ok == GL_FALSE) {
+        char log[512];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        Debug::log(ERR, "[bpp] shader compile failed: {}", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+static GLuint createProgram(const char* vert, const char* frag) {
+    auto vertCompiled = compileShader(GL_VERTEX_SHADER, vert);
+    auto fragCompiled = compileShader(GL_FRAGMENT_SHADER, frag);
+
+    if (!vertCompiled || !fragCompiled) {
+        glDeleteShader(vertCompiled);
+        glDeleteShader(fragCompiled);
+        return 0;
+    }
+
+    auto prog = glCreateProgram();
+    glAttachShader(prog, vertCompiled);
+    glAttachShader(prog, fragCompiled);
+    glLinkProgram(prog);
+
+    glDetachShader(prog, vertCompiled);
+    glDetachShader(prog, fragCompiled);
+    glDeleteShader(vertCompiled);
+    glDeleteShader(fragCompiled);
+
+    GLint ok = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+    if (ok == GL_FALSE) {
+        Debug::log(ERR, "[bpp] shader link failed");
+        glDeleteProgram(prog);
+        return 0;
+    }
+
+    return prog;
+}
+
+CBorderPPRenderer::CBorderPPRenderer() {
+    m_stemShader.program = createProgram(STEMVERTSRC, STEMFRAGSRC);
+    m_stemShader.proj    = glGetUniformLocation(m_stemShader.program, "proj");
+    m_stemShader.color   = glGetUniformLocation(m_stemShader.program, "color");
+    m_stemShader.radius  = glGetUniformLocation(m_stemShader.program, "radius");
+    m_stemShader.pos     = glGetAttribLocation(m_stemShader.program, "pos");
+    m_stemShader.offset  = glGetAttribLocation(m_stemShader.program, "offset");
+    m_stemShader.sway    = glGetAttribLocation(m_stemShader.program, "sway");
+    m_stemShader.time    = glGetUniformLocation(m_stemShader.program, "time");
+    m_stemShader.speed   = glGetUniformLocation(m_stemShader.program, "swaySpeed");
+    m_stemShader.pass    = glGetUniformLocation(m_stemShader.program, "pass");
+
+    glGenVertexArrays(1, &m_stemVao);
+    glGenBuffers(1, &m_stemVbo);
+
+    glBindVertexArray(m_stemVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_stemVbo);
+    glEnableVertexAttribArray(m_stemShader.pos);
+    glVertexAttribPointer(m_stemShader.pos, 2, GL_FLOAT, GL_FALSE, sizeof(SStemVertex), (void*)offsetof(SStemVertex, x));
+    glEnableVertexAttribArray(m_stemShader.offset);
+    glVertexAttribPointer(m_stemShader.offset, 2, GL_FLOAT, GL_FALSE, sizeof(SStemVertex), (void*)offsetof(SStemVertex, across));
+    glEnableVertexAttribArray(m_stemShader.sway);
+    glVertexAttribPointer(m_stemShader.sway, 3, GL_FLOAT, GL_FALSE, sizeof(SStemVertex), (void*)offsetof(SStemVertex, swayX));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_ringShader.program       = createProgram(QUADVERTSRC, RINGFRAGSRC);
+    m_ringShader.proj          = glGetUniformLocation(m_ringShader.program, "proj");
+    m_ringShader.fullSize      = glGetUniformLocation(m_ringShader.program, "fullSize");
+    m_ringShader.halfSize      = glGetUniformLocation(m_ringShader.program, "halfSize");
+    m_ringShader.colors        = glGetUniformLocation(m_ringShader.program, "colors");
+    m_ringShader.rings         = glGetUniformLocation(m_ringShader.program, "rings");
+    m_ringShader.ringCount     = glGetUniformLocation(m_ringShader.program, "ringCount");
+    m_ringShader.roundingPower = glGetUniformLocation(m_ringShader.program, "roundingPower");
+    m_ringShader.alpha         = glGetUniformLocation(m_ringShader.program, "alpha");
+    m_ringShader.pos           = glGetAttribLocation(m_ringShader.program, "pos");
+
+    static const float QUADVERTS[] = {0, 0, 1, 0, 0, 1, 1, 1};
+
+    glGenVertexArrays(1, &m_quadVao);
+    glGenBuffers(1, &m_quadVbo);
+
+    glBindVertexArray(m_quadVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_quadVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(QUADVERTS), QUADVERTS, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(m_ringShader.pos);
+    glVertexAttribPointer(m_ringShader.pos, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_leafShader.program   = createProgram(LEAFVERTSRC, LEAFFRAGSRC);
+    m_leafShader.proj      = glGetUniformLocation(m_leafShader.program, "proj");
+    m_leafShader.time      = glGetUniformLocation(m_leafShader.program, "time");
+    m_leafShader.swaySpeed = glGetUniformLocation(m_leafShader.program, "swaySpeed");
+    m_leafShader.spinSpeed = glGetUniformLocation(m_leafShader.program, "spinSpeed");
+    m_leafShader.corner    = glGetAttribLocation(m_leafShader.program, "corner");
+    m_leafShader.center    = glGetAttribLocation(m_leafShader.program, "center");
+    m_leafShader.sizeSpin  = glGetAttribLocation(m_leafShader.program, "sizeSpin");
+    m_leafShader.sway      = glGetAttribLocation(m_leafShader.program, "sway");
+    m_leafShader.color     = glGetAttribLocation(m_leafShader.program, "color");
+
+    // the unit quad is shared with the rings, the instance buffer steps once per leaf
+    glGenVertexArrays(1, &m_leafVao);
+    glGenBuffers(1, &m_leafVbo);
+
+    glBindVertexArray(m_leafVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_quadVbo);
+    glEnableVertexAttribArray(m_leafShader.corner);
+    glVertexAttribPointer(m_leafShader.corner, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_leafVbo);
+    glEnableVertexAttribArray(m_leafShader.center);
+    glVertexAttribPointer(m_leafShader.center, 2, GL_FLOAT, GL_FALSE, sizeof(SLeafInstance), (void*)offsetof(SLeafInstance, x));
+    glVertexAttribDivisor(m_leafShader.center, 1);
+    glEnableVertexAttribArray(m_leafShader.sizeSpin);
+    glVertexAttribPointer(m_leafShader.sizeSpin, 2, GL_FLOAT, GL_FALSE, sizeof(SLeafInstance), (void*)offsetof(SLeafInstance, size));
+    glVertexAttribDivisor(m_leafShader.sizeSpin, 1);
+    glEnableVertexAttribArray(m_leafShader.sway);
+    glVertexAttribPointer(m_leafShader.sway, 3, GL_FLOAT, GL_FALSE, sizeof(SLeafInstance), (void*)offsetof(SLeafInstance, swayX));
+    glVertexAttribDivisor(m_leafShader.sway, 1);
+    glEnableVertexAttribArray(m_leafShader.color);
+    glVertexAttribPointer(m_leafShader.color, 4, GL_FLOAT, GL_FALSE, sizeof(SLeafInstance), (void*)offsetof(SLeafInstance, color));
+    glVertexAttribDivisor(m_leafShader.color, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+CBorderPPRenderer::~CBorderPPRenderer() {
+    glDeleteBuffers(1, &m_stemVbo);
+    glDeleteVertexArrays(1, &m_stemVao);
+    glDeleteProgram(m_stemShader.program);
+    glDeleteBuffers(1, &m_quadVbo);
+    glDeleteVertexArrays(1, &m_quadVao);
+    glDeleteProgram(m_ringShader.program);
+    glDeleteBuffers(1, &m_leafVbo);
+    glDeleteVertexArrays(1, &m_leafVao);
+    glDeleteProgram(m_leafShader.program);
+}
+
+static CBox toBox(const SBorderPPRect& rect) {
+    return {rect.x, rect.y, rect.w, rect.h};
+}
+
+void CBorderPPRenderer::beginFrame() {
+    m_frameArena.reset();
+}
+
+bool CBorderPPRenderer::pushDamage(const CBox& bounds, const CRegion& damage) {
+    auto& rd = g_pHyprOpenGL->m_renderData;
+
+    // the rings are drawn through the render modifiers, so keep where they end up too
+    CBox  modified = bounds;
+    rd.renderModif.applyToBox(modified);
+
+    const double   X1  = std::min(bounds.x, modified.x), Y1 = std::min(bounds.y, modified.y);
+    const double   X2  = std::max(bounds.x + bounds.width, modified.x + modified.width);
+    const double   Y2  = std::max(bounds.y + bounds.height, modified.y + modified.height);
+    pixman_box32_t box = {(int32_t)std::floor(X1), (int32_t)std::floor(Y1), (int32_t)std::ceil(X2), (int32_t)std::ceil(Y2)};
+    pixman_region32_reset(m_damageBounds.pixman(), &box);
+
+    // intersecting into a region that is neither source keeps its rect storage
+    pixman_region32_intersect(m_narrowedDamage.pixman(), m_damageBounds.pixman(), const_cast<CRegion&>(damage).pixman());
+
+    if (!pixman_region32_not_empty(m_narrowedDamage.pixman()))
+        return false;
+
+    pixman_region32_copy(m_savedDamage.pixman(), rd.damage.pixman());
+    pixman_region32_copy(rd.damage.pixman(), m_narrowedDamage.pixman());
+    return true;
+}
+
+void CBorderPPRenderer::popDamage() {
+    pixman_region32_copy(g_pHyprOpenGL->m_renderData.damage.pixman(), m_savedDamage.pixman());
+}
+
+std::span<const pixman_box32_t> CBorderPPRenderer::clipToDamage(const CBox& bounds) {
+    int         n     = 0;
+    const auto* rects = pixman_region32_rectangles(g_pHyprOpenGL->m_renderData.damage.pixman(), &n);
+
+    const auto  X1 = (int32_t)std::floor(bounds.x), Y1 = (int32_t)std::floor(bounds.y);
+    const auto  X2 = (int32_t)std::ceil(bounds.x + bounds.width), Y2 = (int32_t)std::ceil(bounds.y + bounds.height);
+
+    auto        clipped = m_frameArena.alloc<pixman_box32_t>(n);
+    size_t      count   = 0;
+
+    for (int i = 0; i < n; ++i) {
+        const pixman_box32_t BOX = {std::max(rects[i].x1, X1), std::max(rects[i].y1, Y1), std::min(rects[i].x2, X2), std::min(rects[i].y2, Y2)};
+        if (BOX.x1 < BOX.x2 && BOX.y1 < BOX.y2)
+            clipped[count++] = BOX;
+    }
+
+    return clipped.first(count);
+}
+
+bool CBorderPPRenderer::isDamaged(const SBorderPPRect& rawOuter, const SBorderPPRect& rawInner) {
+    auto&       rd = g_pHyprOpenGL->m_renderData;
+
+    // drawRings() draws through the render modifiers (workspace animations), so test
+    // where the band ends up on screen, not where the layout put it
+    CBox        outerBox = toBox(rawOuter);
+    CBox        innerBox = toBox(rawInner);
+    rd.renderModif.applyToBox(outerBox);
+    if (!rawInner.empty())
+        rd.renderModif.applyToBox(innerBox);
+
+    const SBorderPPRect outer = {outerBox.x, outerBox.y, outerBox.width, outerBox.height};
+    const SBorderPPRect inner = rawInner.empty() ? SBorderPPRect{} : SBorderPPRect{innerBox.x, innerBox.y, innerBox.width, innerBox.height};
+
+    int                 n     = 0;
+    const auto*         rects = pixman_region32_rectangles(rd.damage.pixman(), &n);
+
+    for (int i = 0; i < n; ++i) {
+        const auto& r            = rects[i];
+        const bool  touchesOuter = r.x1 < outer.x + outer.w && r.x2 > outer.x && r.y1 < outer.y + outer.h && r.y2 > outer.y;
+        const bool  insideInner  = !inner.empty() && r.x1 >= inner.x && r.x2 <= inner.x + inner.w && r.y1 >= inner.y && r.y2 <= inner.y + inner.h;
+        if (touchesOuter && !insideInner)
+            return true;
+    }
+
+    return false;
+}
+
+SBorderPPRect CBorderPPRenderer::viewport() {
+    const auto& rd = g_pHyprOpenGL->m_renderData;
+
+    // the vine cache is drawn on every monitor the window is on, and render
+    // modifiers move geometry after the fact, so neither can be culled here
+    if (m_bOffscreen || !rd.pMonitor || (rd.renderModif.enabled && !rd.renderModif.modifs.empty()))
+        return UNBOUNDED_VIEWPORT;
+
+    return {0, 0, rd.pMonitor->m_pixelSize.x, rd.pMonitor->m_pixelSize.y};
+}
+
+void CBorderPPRenderer::drawLeaves(std::span<const SLeafInstance> leaves, const SBorderPPRect& bounds, float time) {
+    if (leaves.empty() || !m_leafShader.program)
+        return;
+
+    const auto CLIP = clipToDamage(toBox(bounds));
+    if (CLIP.empty())
+        return;
+
+    const auto GLMATRIX = g_pHyprOpenGL->m_renderData.projection.copy().multiply(g_pHyprOpenGL->m_renderData.monitorProjection);
+
+    g_pHyprOpenGL->blend(true);
+
+    glUseProgram(m_leafShader.program);
+    glUniformMatrix3fv(m_leafShader.proj, 1, GL_TRUE, GLMATRIX.getMatrix().data());
+    glUniform1f(m_leafShader.time, time);
+    glUniform1f(m_leafShader.swaySpeed, VINE_SWAY_SPEED);
+    glUniform1f(m_leafShader.spinSpeed, VINE_LEAF_SPIN_SPEED);
+
+    glBindVertexArray(m_leafVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_leafVbo);
+    glBufferData(GL_ARRAY_BUFFER, leaves.size() * sizeof(SLeafInstance), leaves.data(), GL_STREAM_DRAW);
+
+    for (auto const& RECT : CLIP) {
+        g_pHyprOpenGL->scissor(&RECT);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, leaves.size());
+    }
+
+    m_issued.drawCalls += CLIP.size();
+    m_issued.triangles += CLIP.size() * leaves.size() * 2;
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CBorderPPRenderer::drawStems(std::span<const SStemVertex> verts, const SBorderPPRect& bounds, const SBorderPPColor& col, float radius, float time) {
+    if (verts.size() < 3 || !m_stemShader.program)
+        return;
+
+    const auto CLIP = clipToDamage(toBox(bounds));
+    if (CLIP.empty())
+        return;
+
+    const auto GLMATRIX = g_pHyprOpenGL->m_renderData.projection.copy().multiply(g_pHyprOpenGL->m_renderData.monitorProjection);
+
+    g_pHyprOpenGL->blend(true);
+
+    glUseProgram(m_stemShader.program);
+    glUniformMatrix3fv(m_stemShader.proj, 1, GL_TRUE, GLMATRIX.getMatrix().data());
+    glUniform4f(m_stemShader.color, col.r * col.a, col.g * col.a, col.b * col.a, col.a);
+    glUniform1f(m_stemShader.radius, radius);
+    glUniform1f(m_stemShader.time, time);
+    glUniform1f(m_stemShader.speed, VINE_SWAY_SPEED);
+
+    glBindVertexArray(m_stemVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_stemVbo);
+    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(SStemVertex), verts.data(), GL_STREAM_DRAW);
+
+    // Overlapping strands and joins mustn't blend over themselves. The fully covered
+    // cores are drawn first and mark the stencil, so each core pixel is shaded once;
+    // the antialiased edges then only land where no core is, and a faint edge can't
+    // notch a crossing strand. The stencil belongs to the current framebuffer, so it
+    // is only touched inside the clip rects and left cleared, as Hyprland expects it
+    glEnable(GL_STENCIL_TEST);
+    glClearStencil(0);
+
+    for (auto const& RECT : CLIP) {
+        g_pHyprOpenGL->scissor(&RECT);
+        glClear(GL_STENCIL_BUFFER_BIT);
+
+        glStencilFunc(GL_EQUAL, 0, 0xFF);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+        glUniform1i(m_stemShader.pass, 1);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, verts.size());
+
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        glUniform1i(m_stemShader.pass, 2);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, verts.size());
+
+        glClear(GL_STENCIL_BUFFER_BIT);
+    }
+
+    m_issued.drawCalls += CLIP.size() * 2;
+    m_issued.triangles += CLIP.size() * 2 * (verts.size() - 2);
+
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    glDisable(GL_STENCIL_TEST);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CBorderPPRenderer::drawRings(const SBorderPPRect& box, std::span<const SBorderRing> rings, float roundingPower, float a) {
+    if (rings.empty() || rings.size() > 9 || !m_ringShader.program)
+        return;
+
+    auto&       rd    = g_pHyprOpenGL->m_renderData;
+    const float SCALE = rd.renderModif.combinedScale();
+
+    CBox        innerBox = toBox(box);
+    rd.renderModif.applyToBox(innerBox);
+
+    const float OUTER   = rings.back().outer * SCALE + 1.F; // +1 for the antialiased edge
+    CBox        fullBox = innerBox.copy().expand(OUTER);
+
+    const auto  CLIP = clipToDamage(fullBox);
+    if (CLIP.empty())
+        return;
+
+    std::array<float, 9 * 4> colors;
+    std::array<float, 9 * 4> ringData;
+    for (size_t i = 0; i < rings.size(); ++i) {
+        const auto& R     = rings[i];
+        colors[i * 4]     = R.color.r * R.color.a;
+        colors[i * 4 + 1] = R.color.g * R.color.a;
+        colors[i * 4 + 2] = R.color.b * R.color.a;
+        colors[i * 4 + 3] = R.color.a;
+
+        ringData[i * 4]     = R.inner * SCALE;
+        ringData[i * 4 + 1] = R.outer * SCALE;
+        ringData[i * 4 + 2] = R.innerRound * SCALE;
+        ringData[i * 4 + 3] = R.outerRound * SCALE;
+    }
+
+    const auto MATRIX   = rd.monitorProjection.projectBox(fullBox, HYPRUTILS_TRANSFORM_NORMAL, fullBox.rot);
+    const auto GLMATRIX = rd.projection.copy().multiply(MATRIX);
+
+    g_pHyprOpenGL->blend(true);
+
+    glUseProgram(m_ringShader.program);
+    glUniformMatrix3fv(m_ringShader.proj, 1, GL_TRUE, GLMATRIX.getMatrix().data());
+    glUniform2f(m_ringShader.fullSize, fullBox.width, fullBox.height);
+    glUniform2f(m_ringShader.halfSize, innerBox.width / 2.F, innerBox.height / 2.F);
+    glUniform4fv(m_ringShader.colors, rings.size(), colors.data());
+    glUniform4fv(m_ringShader.rings, rings.size(), ringData.data());
+    glUniform1i(m_ringShader.ringCount, rings.size());
+    glUniform1f(m_ringShader.roundingPower, roundingPower);
+    glUniform1f(m_ringShader.alpha, a);
+
+    glBindVertexArray(m_quadVao);
+
+    for (auto const& RECT : CLIP) {
+        g_pHyprOpenGL->scissor(&RECT);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+
+    m_issued.drawCalls += CLIP.size();
+    m_issued.triangles += CLIP.size() * 2;
+
+    glBindVertexArray(0);
+}
+
+void CBorderPPRenderer::beginOffscreen(CFramebuffer& fb) {
+    auto& rd = g_pHyprOpenGL->m_renderData;
+
+    m_bOffscreen                     = true;
+    m_savedTarget.fb                 = rd.currentFB;
+    m_savedTarget.projection         = rd.projection;
+    m_savedTarget.monitorProjection  = rd.monitorProjection;
+    m_savedTarget.damage             = rd.damage;
+    m_savedTarget.clipBox            = rd.clipBox;
+    m_savedTarget.renderModifEnabled = rd.renderModif.enabled;
+
+    fb.bind();
+    glViewport(0, 0, fb.m_size.x, fb.m_size.y);
+
+    rd.projection          = Mat3x3::outputProjection(fb.m_size, HYPRUTILS_TRANSFORM_NORMAL);
+    rd.monitorProjection   = Mat3x3::identity();
+    rd.damage              = CRegion{0, 0, fb.m_size.x, fb.m_size.y};
+    rd.clipBox             = {};
+    rd.renderModif.enabled = false;
+
+    g_pHyprOpenGL->scissor(nullptr);
+    glClearColor(0, 0, 0, 0);
+    glClearStencil(0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+}
+
+void CBorderPPRenderer::endOffscreen() {
+    auto& rd = g_pHyprOpenGL->m_renderData;
+
+    if (m_savedTarget.fb)
+        m_savedTarget.fb->bind();
+
+    glViewport(0, 0, rd.pMonitor->m_pixelSize.x, rd.pMonitor->m_pixelSize.y);
+
+    rd.projection          = m_savedTarget.projection;
+    rd.monitorProjection   = m_savedTarget.monitorProjection;
+    rd.damage              = m_savedTarget.damage;
+    rd.clipBox             = m_savedTarget.clipBox;
+    rd.renderModif.enabled = m_savedTarget.renderModifEnabled;
+
+    m_savedTarget.fb = nullptr;
+    m_bOffscreen     = false;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/render/OpenGL.hpp>
+#include <array>
+#include <span>
+#include <vector>
+
+#include "BorderppCore.hpp"
+#include "BorderppFrameArena.hpp"
+
+class CBorderPPRenderer : public IBorderPPRenderer {
+  public:
+    CBorderPPRenderer();
+    virtual ~CBorderPPRenderer();
+
+    // Stems are clipped to bounds intersected with the current damage
+    virtual void drawStems(std::span<const SStemVertex> verts, const SBorderPPRect& bounds, const SBorderPPColor& col, float radius, float time);
+
+    // Draws all rings in one call, box is in render target pixels before the render modifiers
+    virtual void drawRings(const SBorderPPRect& box, std::span<const SBorderRing> rings, float roundingPower, float a);
+
+    // All leaves in one instanced call, clipped like the stems
+    virtual void drawLeaves(std::span<const SLeafInstance> leaves, const SBorderPPRect& bounds, float time);
+
+    // Tests against g_pHyprOpenGL's current damage, after the render modifiers
+    virtual bool isDamaged(const SBorderPPRect& outer, const SBorderPPRect& inner = {});
+
+    // The current monitor, unbounded offscreen or under render modifiers
+    virtual SBorderPPRect viewport();
+
+    // Narrows the current damage to bounds until popDamage(), returns false
+    // (without narrowing) if they don't overlap. Reuses the same regions every
+    // frame, so it doesn't allocate once they are big enough.
+    bool pushDamage(const CBox& bounds, const CRegion& damage);
+    void popDamage();
+
+    // Called once per frame, frees everything the last frame took from the arena
+    void beginFrame();
+
+    // What was submitted to GL so far, sampled around each pass for the perf counters
+    struct SIssued {
+        uint64_t drawCalls = 0;
+        uint64_t triangles = 0;
+    } m_issued;
+
+    // Redirects rendering into fb until endOffscreen(), with the projection,
+    // damage and render modifiers set up for the framebuffer instead of the monitor.
+    void beginOffscreen(CFramebuffer& fb);
+    void endOffscreen();
+
+  private:
+    // Scissor rects for bounds clipped to the current damage, valid until beginFrame()
+    std::span<const pixman_box32_t> clipToDamage(const CBox& bounds);
+
+    CBorderPPFrameArena m_frameArena;
+
+    CRegion             m_damageBounds;
+    CRegion             m_narrowedDamage;
+    CRegion             m_savedDamage;
+
+    bool                m_bOffscreen = false;
+
+    struct {
+        CFramebuffer*   fb = nullptr;
+        Mat3x3          projection;
+        Mat3x3          monitorProjection;
+        CRegion         damage;
+        CBox            clipBox;
+        bool            renderModifEnabled = false;
+    } m_savedTarget;
+
+    struct {
+        GLuint program = 0;
+        GLint  proj    = -1;
+        GLint  color   = -1;
+        GLint  radius  = -1;
+        GLint  time    = -1;
+        GLint  speed   = -1;
+        GLint  pass    = -1;
+        GLint  pos     = -1;
+        GLint  offset  = -1;
+        GLint  sway    = -1;
+    } m_stemShader;
+
+    GLuint m_stemVao = 0;
+    GLuint m_stemVbo = 0;
+
+    struct {
+        GLuint program       = 0;
+        GLint  proj          = -1;
+        GLint  fullSize      = -1;
+        GLint  halfSize      = -1;
+        GLint  colors        = -1;
+        GLint  rings         = -1;
+        GLint  ringCount     = -1;
+        GLint  roundingPower = -1;
+        GLint  alpha         = -1;
+        GLint  pos           = -1;
+    } m_ringShader;
+
+    GLuint m_quadVao = 0;
+    GLuint m_quadVbo = 0;
+
+    struct {
+        GLuint program   = 0;
+        GLint  proj      = -1;
+        GLint  time      = -1;
+        GLint  swaySpeed = -1;
+        GLint  spinSpeed = -1;
+        GLint  corner    = -1;
+        GLint  center    = -1;
+        GLint  sizeSpin  = -1;
+        GLint  sway      = -1;
+        GLint  color     = -1;
+    } m_leafShader;
+
+    GLuint m_leafVao = 0;
+    GLuint m_leafVbo = 0; // per-instance SLeafInstance
+};
+
+inline UP<CBorderPPRenderer> g_pBorderPPRenderer;
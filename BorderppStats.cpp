@@ -0,0 +1,77 @@
+#include "BorderppStats.hpp"
+#include "borderDeco.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/desktop/Window.hpp>
+#include <algorithm>
+#include <bit>
+#include <format>
+
+static void bump(std::atomic<uint64_t>& counter, uint64_t n) {
+    counter.fetch_add(n, std::memory_order_relaxed);
+}
+
+static uint64_t read(const std::atomic<uint64_t>& counter) {
+    return counter.load(std::memory_order_relaxed);
+}
+
+void SBorderPPCounters::add(std::atomic<uint64_t> SBorderPPCounters::*counter, uint64_t n) {
+    bump(this->*counter, n);
+    bump(g_borderPPCounters.*counter, n);
+}
+
+void SBorderPPCounters::addPass(uint64_t ns) {
+    const size_t BUCKET = std::min<size_t>(std::bit_width(ns / 1000), PASS_TIME_BUCKETS - 1);
+
+    for (auto* counters : {this, &g_borderPPCounters}) {
+        bump(counters->passes, 1);
+        bump(counters->passTimeNs, ns);
+        bump(counters->passTimeHistogram[BUCKET], 1);
+    }
+}
+
+std::string SBorderPPCounters::toJson() const {
+    std::string histogram;
+    for (size_t i = 0; i < PASS_TIME_BUCKETS; ++i) {
+        histogram += std::format("{}{}", i == 0 ? "" : ", ", read(passTimeHistogram[i]));
+    }
+
+    return std::format(R"#({{"passes": {}, "passTimeNs": {}, "passTimeHistogramUs": [{}], "drawCalls": {}, "primitives": {}, "regenerations": {}, "growthWakeups": {}, "damageArea": {}, "animationDamageArea": {}}})#",
+                       read(passes), read(passTimeNs), histogram, read(drawCalls), read(primitives), read(regenerations), read(growthWakeups), read(damageArea),
+                       read(animationDamageArea));
+}
+
+static std::string escapeJson(const std::string& str) {
+    std::string out;
+    for (const char C : str) {
+        if (C == '"' || C == '\\')
+            out += '\\';
+        else if ((unsigned char)C < 0x20) {
+            out += std::format("\\u{:04x}", (int)C);
+            continue;
+        }
+
+        out += C;
+    }
+
+    return out;
+}
+
+std::string borderPPStatsJson() {
+    std::string decorations;
+
+    for (auto const& w : g_pCompositor->m_windows) {
+        for (auto const& deco : w->m_windowDecorations) {
+            const auto* const PDECO = dynamic_cast<CBordersPlusPlus*>(deco.get());
+            if (!PDECO)
+                continue;
+
+            static constexpr const char* TIERS[] = {"full", "cached", "borders", "none"};
+
+            decorations += std::format(R"#({}{{"window": "{:x}", "class": "{}", "tier": "{}", "counters": {}}})#", decorations.empty() ? "" : ",\n    ", (uintptr_t)w.get(),
+                                       escapeJson(w->m_class), TIERS[PDECO->tier()], PDECO->counters().toJson());
+        }
+    }
+
+    return std::format("{{\n  \"global\": {},\n  \"decorations\": [\n    {}\n  ]\n}}\n", g_borderPPCounters.toJson(), decorations);
+}
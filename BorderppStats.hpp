@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// CPU time per pass in power of two buckets of microseconds:
+// [0, 1), [1, 2), [2, 4) ... and everything from 2^14 up in the last one
+constexpr size_t PASS_TIME_BUCKETS = 16;
+
+// What one decoration, or the whole plugin, has cost since it was created.
+// Only relaxed atomic adds on the render path, so they stay on in release
+// builds and can be read from anywhere without taking a lock.
+struct SBorderPPCounters {
+    std::atomic<uint64_t>                                 passes;
+    std::atomic<uint64_t>                                 passTimeNs;
+    std::array<std::atomic<uint64_t>, PASS_TIME_BUCKETS> passTimeHistogram;
+    std::atomic<uint64_t>                                 drawCalls;
+    std::atomic<uint64_t>                                 primitives; // triangles submitted
+    std::atomic<uint64_t>                                 regenerations;
+    std::atomic<uint64_t>                                 growthWakeups;       // plugin-wide: timer wakeups, per decoration: ticks delivered
+    std::atomic<uint64_t>                                 damageArea;          // logical px² requested by damageEntire
+    std::atomic<uint64_t>                                 animationDamageArea; // logical px² of the strips damaged for vine_animate
+
+    // Adds n to counter here and in the plugin-wide counters, so only call it on a decoration's
+    void        add(std::atomic<uint64_t> SBorderPPCounters::*counter, uint64_t n);
+    void        addPass(uint64_t ns);
+
+    std::string toJson() const;
+};
+
+inline SBorderPPCounters g_borderPPCounters;
+
+// Plugin-wide counters and those of every decoration, for the hyprctl command
+std::string borderPPStatsJson();
@@ -0,0 +1,93 @@
+#include "BorderppTrace.hpp"
+
+#ifdef BORDERPP_TRACE
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+
+static_assert((TRACE_CAPACITY & (TRACE_CAPACITY - 1)) == 0, "TRACE_CAPACITY must be a power of two");
+
+// One zone. Writers claim a slot by bumping the head, fill it in and publish
+// it by storing its sequence number last; the flush skips slots whose
+// sequence changed while it read them, so nobody ever waits on a lock.
+struct STraceSlot {
+    std::atomic<uint64_t>    sequence = 0; // index + 1 of the zone in the slot, 0 while being written
+    std::atomic<const char*> name     = nullptr;
+    std::atomic<uint64_t>    startNs  = 0;
+    std::atomic<uint64_t>    endNs    = 0;
+    std::atomic<uint32_t>    tid      = 0;
+};
+
+static std::array<STraceSlot, TRACE_CAPACITY> g_traceSlots;
+static std::atomic<uint64_t>                   g_traceHead = 0;
+
+uint64_t borderPPTraceNow() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+void borderPPTraceRecord(const char* name, uint64_t startNs, uint64_t endNs) {
+    thread_local const uint32_t TID = gettid();
+
+    const uint64_t              INDEX = g_traceHead.fetch_add(1, std::memory_order_relaxed);
+    auto&                       slot  = g_traceSlots[INDEX & (TRACE_CAPACITY - 1)];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.endNs.store(endNs, std::memory_order_relaxed);
+    slot.tid.store(TID, std::memory_order_relaxed);
+    slot.sequence.store(INDEX + 1, std::memory_order_release);
+}
+
+int borderPPTraceFlush(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+        return -1;
+
+    const uint64_t HEAD  = g_traceHead.load(std::memory_order_acquire);
+    const uint64_t FIRST = HEAD > TRACE_CAPACITY ? HEAD - TRACE_CAPACITY : 0;
+    const int      PID   = getpid();
+    int            count = 0;
+
+    std::fputs("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n", file);
+
+    for (uint64_t i = FIRST; i < HEAD; ++i) {
+        const auto& slot = g_traceSlots[i & (TRACE_CAPACITY - 1)];
+
+        if (slot.sequence.load(std::memory_order_acquire) != i + 1)
+            continue;
+
+        const char*    NAME  = slot.name.load(std::memory_order_relaxed);
+        const uint64_t START = slot.startNs.load(std::memory_order_relaxed);
+        const uint64_t END   = slot.endNs.load(std::memory_order_relaxed);
+        const uint32_t TID   = slot.tid.load(std::memory_order_relaxed);
+
+        // overwritten while we were reading it
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != i + 1)
+            continue;
+
+        std::fprintf(file, "%s{\"name\": \"%s\", \"cat\": \"bpp\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": %d, \"tid\": %u}", count == 0 ? "" : ",\n", NAME,
+                     START / 1000.0, (END - START) / 1000.0, PID, TID);
+        count++;
+    }
+
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+
+    return count;
+}
+
+std::string borderPPTraceDefaultPath() {
+    const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+    return std::string(runtimeDir && *runtimeDir ? runtimeDir : "/tmp") + "/borders-plus-plus.trace.json";
+}
+
+#endif
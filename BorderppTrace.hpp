@@ -0,0 +1,52 @@
+#pragma once
+
+// Scoped trace zones for lining plugin work up against Hyprland's frames.
+// Only compiled in with BORDERPP_TRACE defined (make TRACE=1, meson -Dtrace=true,
+// cmake -DBORDERPP_TRACE=ON); otherwise BPP_TRACE_ZONE expands to nothing.
+
+#ifdef BORDERPP_TRACE
+
+#include <cstdint>
+#include <string>
+
+// Zones kept in the ring buffer, the oldest are overwritten
+constexpr size_t TRACE_CAPACITY = 1 << 16;
+
+uint64_t         borderPPTraceNow();
+void             borderPPTraceRecord(const char* name, uint64_t startNs, uint64_t endNs);
+
+// Writes the zones in the buffer to path as Chrome trace JSON (loads in Perfetto too)
+// Returns the number of zones written, or -1 if the file can't be opened
+int              borderPPTraceFlush(const std::string& path);
+
+// Default destination of borderPPTraceFlush: $XDG_RUNTIME_DIR, or /tmp without it
+std::string      borderPPTraceDefaultPath();
+
+class CBorderPPTraceZone {
+  public:
+    explicit CBorderPPTraceZone(const char* name) : m_name(name), m_iStart(borderPPTraceNow()) {
+        ;
+    }
+
+    ~CBorderPPTraceZone() {
+        borderPPTraceRecord(m_name, m_iStart, borderPPTraceNow());
+    }
+
+    CBorderPPTraceZone(const CBorderPPTraceZone&)            = delete;
+    CBorderPPTraceZone& operator=(const CBorderPPTraceZone&) = delete;
+
+  private:
+    const char* m_name   = nullptr;
+    uint64_t    m_iStart = 0;
+};
+
+#define BPP_TRACE_CONCAT_(a, b) a##b
+#define BPP_TRACE_CONCAT(a, b)  BPP_TRACE_CONCAT_(a, b)
+// name has to outlive the plugin, use a string literal
+#define BPP_TRACE_ZONE(name) CBorderPPTraceZone BPP_TRACE_CONCAT(bppTraceZone, __LINE__)(name)
+
+#else
+
+#define BPP_TRACE_ZONE(name)
+
+#endif
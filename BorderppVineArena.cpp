@@ -0,0 +1,117 @@
+#include "BorderppVineArena.hpp"
+#include "BorderppVineKernel.hpp"
+
+#include <cmath>
+
+void CBorderPPVineArena::reset(size_t strands, size_t segments) {
+    m_segments = segments;
+    m_stride   = segments + 2;
+
+    // clear() keeps the capacity, so relayouts after the first one don't allocate
+    m_strands.clear();
+    m_strands.reserve(strands);
+    m_counts.clear();
+    m_counts.reserve(strands);
+}
+
+size_t CBorderPPVineArena::addStrand(uint32_t edge, float start, float fullLength, float phase) {
+    m_strands.push_back({.edge = edge, .start = start, .fullLength = fullLength, .phase = phase});
+    m_counts.push_back(0);
+    return m_strands.size() - 1;
+}
+
+void CBorderPPVineArena::generate(const std::array<SVineEdgeShape, 4>& shapes, float curviness) {
+    m_shapes    = shapes;
+    m_curviness = curviness;
+}
+
+float CBorderPPVineArena::gridOffset(size_t idx, size_t k) const {
+    const auto& SHAPE  = m_shapes[m_strands[idx].edge];
+    const float OFFSET = SHAPE.tmpl->offset(idx % SHAPE.tmpl->strands, k) * m_curviness;
+    return SHAPE.mirror ? -OFFSET : OFFSET;
+}
+
+size_t CBorderPPVineArena::growStrand(size_t idx, float length) {
+    auto&        strand  = m_strands[idx];
+    auto&        count   = m_counts[idx];
+    const float  SPACING = strand.fullLength / m_segments;
+
+    // the tip is the only point that moves, drop it and re-add it further out
+    const size_t FIRSTCHANGED = strand.committed > 0 ? strand.committed - 1 : 0;
+
+    while (strand.committed <= m_segments && strand.committed * SPACING <= length) {
+        strand.committed++;
+    }
+
+    count = strand.committed;
+
+    // the tip sits between grid points, so it's the one offset the template can't hold
+    if (strand.committed <= m_segments && length > (strand.committed - 1) * SPACING + 0.0001F) {
+        const auto& SHAPE  = m_shapes[strand.edge];
+        const float WAVE   = vineFastSin(length / strand.fullLength * 3.F * (float)M_PI + strand.phase);
+        const float NOISE  = vineNoise(SHAPE.tmpl->seed, idx % SHAPE.tmpl->strands, strand.committed);
+        const float OFFSET = m_curviness * (WAVE * 2.F + NOISE * 0.3F);
+
+        strand.tipOffset = SHAPE.mirror ? -OFFSET : OFFSET;
+        count++;
+    }
+
+    strand.length = length;
+
+    return FIRSTCHANGED;
+}
+
+void CBorderPPVineArena::map(SVineMapping& mapping, const std::array<SVineEdge, 4>& edges, float scale) const {
+    mapping.edges = edges;
+    mapping.scale = scale;
+
+    // resize() keeps the capacity, so remapping never allocates once sized
+    const size_t POINTS = m_strands.size() * m_stride;
+    mapping.x.resize(POINTS);
+    mapping.y.resize(POINTS);
+    mapping.tx.resize(POINTS);
+    mapping.ty.resize(POINTS);
+
+    for (size_t i = 0; i < m_strands.size(); ++i) {
+        mapGrown(mapping, i, 0);
+    }
+}
+
+SVinePath CBorderPPVineArena::path(const SVineMapping& mapping, size_t i) const {
+    const size_t BASE = i * m_stride;
+    return {mapping.x.data() + BASE, mapping.y.data() + BASE, mapping.tx.data() + BASE, mapping.ty.data() + BASE, m_counts[i]};
+}
+
+void CBorderPPVineArena::mapGrown(SVineMapping& mapping, size_t idx, size_t from) const {
+    const auto&  STRAND  = m_strands[idx];
+    const auto&  EDGE    = mapping.edges[STRAND.edge];
+    const size_t BASE    = idx * m_stride;
+    const size_t COUNT   = m_counts[idx];
+    const float  SPACING = STRAND.fullLength / m_segments;
+
+    float*       x  = mapping.x.data() + BASE;
+    float*       y  = mapping.y.data() + BASE;
+    float*       tx = mapping.tx.data() + BASE;
+    float*       ty = mapping.ty.data() + BASE;
+
+    // grid points come from the template, the tip (past the committed ones) from the strand
+    for (size_t i = from; i < COUNT; ++i) {
+        const bool  TIP    = i >= STRAND.committed;
+        const float ALONG  = (STRAND.start + (TIP ? STRAND.length : i * SPACING)) * EDGE.length;
+        const float ACROSS = (TIP ? STRAND.tipOffset : gridOffset(idx, i)) * mapping.scale;
+        x[i]               = EDGE.x + EDGE.dx * ALONG - EDGE.dy * ACROSS;
+        y[i]               = EDGE.y + EDGE.dy * ALONG + EDGE.dx * ACROSS;
+    }
+
+    // moving a point changes the tangent of its neighbour too
+    for (size_t i = from > 0 ? from - 1 : 0; i < COUNT; ++i) {
+        const size_t A   = i == 0 ? 0 : i - 1;
+        const size_t B   = i + 1 == COUNT ? i : i + 1;
+        const float  DX  = x[B] - x[A];
+        const float  DY  = y[B] - y[A];
+        const float  LEN = std::sqrt(DX * DX + DY * DY);
+
+        tx[i] = LEN > 0.0001F ? DX / LEN : EDGE.dx;
+        ty[i] = LEN > 0.0001F ? DY / LEN : EDGE.dy;
+    }
+}
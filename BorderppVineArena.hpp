@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+// One vine strand along an edge, in edge-parameter space
+// Points sit on a fixed grid over the strand's full length, growth only appends
+struct SVineStrand {
+    uint32_t edge       = 0; // 0 top, 1 right, 2 bottom, 3 left
+    float    start      = 0; // along the edge
+    float    fullLength = 0; // along the edge
+    float    length     = 0; // currently grown length
+    float    phase      = 0; // wave phase, fixed at creation
+    uint32_t committed  = 0; // grid points placed so far, the tip is extra
+    float    tipOffset  = 0; // of the tip, which sits between grid points
+};
+
+// The shape of the strands along one edge at one level of detail, shared by all
+// edges that use it: the offset of each grid point for a curviness of 1
+struct SVineTemplate {
+    size_t                      strands  = 0;
+    size_t                      segments = 0;
+    uint32_t                    seed     = 0; // of the noise, the tips use it too
+    std::span<const float>      grid;         // segments + 1 offsets per strand
+
+    // what grid points into: either owned, or a cache file mapping kept alive by backing
+    std::vector<float>          owned;
+    std::shared_ptr<const void> backing;
+
+    float                       offset(size_t strand, size_t k) const {
+        return grid[strand * (segments + 1) + k];
+    }
+};
+
+// How one edge of a decoration wears a template, derived from the edge's seed
+struct SVineEdgeShape {
+    std::shared_ptr<const SVineTemplate> tmpl;
+    bool                                 mirror = false; // offsets point the other way
+};
+
+// An edge of the box the vines are mapped onto, in pixels
+struct SVineEdge {
+    float x = 0, y = 0;   // where the edge starts
+    float dx = 1, dy = 0; // unit direction along the edge
+    float length = 0;
+};
+
+// Read-only view of one strand's mapped points
+struct SVinePath {
+    const float* x  = nullptr;
+    const float* y  = nullptr;
+    const float* tx = nullptr; // unit tangent
+    const float* ty = nullptr;
+    size_t       count = 0;
+};
+
+// The strands of an arena mapped onto one box, in pixels. Kept apart from the
+// arena so the same strands can be mapped onto several monitors at once.
+struct SVineMapping {
+    std::array<SVineEdge, 4> edges;
+    float                    scale = 1.F;
+    std::vector<float>       x, y;
+    std::vector<float>       tx, ty; // unit tangent
+};
+
+// The vines of one decoration: its strands and how far they have grown, over a shared
+// template that holds the actual shape. Every strand owns a fixed slot of segments + 2
+// points (the grid plus the moving tip) in the mappings, so growth appends in place.
+class CBorderPPVineArena {
+  public:
+    // Drops all strands, for strands of segments each
+    void   reset(size_t strands, size_t segments);
+
+    // Adds an empty strand
+    size_t addStrand(uint32_t edge, float start, float fullLength, float phase);
+
+    // Shapes the strands added since reset() after the template of their edge, scaled by
+    // curviness. Strands must have been added edge by edge, as many per edge as the
+    // templates hold. The offsets are fixed by the templates, so growth only reveals them
+    void   generate(const std::array<SVineEdgeShape, 4>& shapes, float curviness);
+
+    // Extends a strand to length (in edge parameter), appending points past its tip only.
+    // Returns the index of the first point that changed (the old tip), for mapGrown()
+    size_t growStrand(size_t strand, float length);
+
+    // Maps every strand onto edges (top, right, bottom, left) into mapping, with tangents
+    void   map(SVineMapping& mapping, const std::array<SVineEdge, 4>& edges, float scale) const;
+
+    // Maps the points of a strand from index from on, after growStrand()
+    void   mapGrown(SVineMapping& mapping, size_t strand, size_t from) const;
+
+    size_t strands() const {
+        return m_strands.size();
+    }
+
+    const SVineStrand& strand(size_t i) const {
+        return m_strands[i];
+    }
+
+    SVinePath path(const SVineMapping& mapping, size_t i) const;
+
+  private:
+    // Offset of grid point k of a strand, in logical px
+    float                                gridOffset(size_t strand, size_t k) const;
+
+    size_t                               m_segments = 0;
+    size_t                               m_stride   = 0;
+
+    std::vector<SVineStrand>             m_strands;
+    std::vector<uint32_t>                m_counts; // points in each strand's slot
+
+    std::array<SVineEdgeShape, 4>        m_shapes;
+    float                                m_curviness = 0;
+};
@@ -0,0 +1,159 @@
+#include "BorderppVineKernel.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BPP_VINE_KERNEL_X86
+#endif
+
+constexpr float PI         = 3.14159265358979F;
+constexpr float WAVES      = 3.F * PI;  // one and a half waves per strand
+constexpr float WAVESCALE  = 2.F;       // wave amplitude, in curviness
+constexpr float NOISESCALE = 0.3F;      // noise amplitude, in curviness
+constexpr float NOISEUNIT  = 1.F / 8388608.F;
+
+static void offsetsScalar(const SVineKernelJob& job, size_t strand, size_t from) {
+    const auto& STRAND = job.strands[strand];
+    float*      out    = job.out + strand * job.stride;
+    const float STEP   = WAVES / job.segments;
+
+    for (size_t k = from; k < job.points; ++k) {
+        const float WAVE  = vineFastSin(k * STEP + STRAND.phase);
+        const float NOISE = vineNoise(job.seed, strand, k);
+        out[k]            = job.curviness * (WAVE * WAVESCALE + NOISE * NOISESCALE);
+    }
+}
+
+static void kernelScalar(const SVineKernelJob& job) {
+    for (size_t s = 0; s < job.count; ++s) {
+        offsetsScalar(job, s, 0);
+    }
+}
+
+#ifdef BPP_VINE_KERNEL_X86
+
+__attribute__((target("sse4.1"))) static __m128 sin4(__m128 x) {
+    const __m128 SIGNMASK = _mm_set1_ps(-0.F);
+
+    x = _mm_sub_ps(x, _mm_mul_ps(_mm_round_ps(_mm_mul_ps(x, _mm_set1_ps(0.5F / PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm_set1_ps(2.F * PI)));
+
+    const __m128 SIGN = _mm_and_ps(x, SIGNMASK);
+    __m128       a    = _mm_andnot_ps(SIGNMASK, x);
+    a                 = _mm_min_ps(a, _mm_sub_ps(_mm_set1_ps(PI), a));
+
+    const __m128 A2 = _mm_mul_ps(a, a);
+    __m128       p  = _mm_set1_ps(1.F / 362880.F);
+    p               = _mm_add_ps(_mm_mul_ps(p, A2), _mm_set1_ps(-1.F / 5040.F));
+    p               = _mm_add_ps(_mm_mul_ps(p, A2), _mm_set1_ps(1.F / 120.F));
+    p               = _mm_add_ps(_mm_mul_ps(p, A2), _mm_set1_ps(-1.F / 6.F));
+    p               = _mm_add_ps(_mm_mul_ps(p, A2), _mm_set1_ps(1.F));
+
+    return _mm_xor_ps(_mm_mul_ps(a, p), SIGN);
+}
+
+__attribute__((target("sse4.1"))) static __m128 noise4(__m128i x) {
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    x = _mm_mullo_epi32(x, _mm_set1_epi32(0x7feb352d));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+    x = _mm_mullo_epi32(x, _mm_set1_epi32((int)0x846ca68bU));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    return _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(x, 8)), _mm_set1_ps(NOISEUNIT)), _mm_set1_ps(1.F));
+}
+
+__attribute__((target("sse4.1"))) static void kernelSSE41(const SVineKernelJob& job) {
+    const __m128  STEP  = _mm_set1_ps(WAVES / job.segments);
+    const __m128  CURVE = _mm_set1_ps(job.curviness);
+    const __m128i IOTA  = _mm_setr_epi32(0, 1, 2, 3);
+
+    for (size_t s = 0; s < job.count; ++s) {
+        const __m128  PHASE = _mm_set1_ps(job.strands[s].phase);
+        const __m128i KEY   = _mm_set1_epi32((int)(job.seed ^ (uint32_t)(s * 0x9E3779B9U)));
+        float*        out   = job.out + s * job.stride;
+
+        size_t        k = 0;
+        for (; k + 4 <= job.points; k += 4) {
+            const __m128i K     = _mm_add_epi32(_mm_set1_epi32((int)k), IOTA);
+            const __m128  WAVE  = sin4(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(K), STEP), PHASE));
+            const __m128  NOISE = noise4(_mm_add_epi32(KEY, K));
+            const __m128  SUM   = _mm_add_ps(_mm_mul_ps(WAVE, _mm_set1_ps(WAVESCALE)), _mm_mul_ps(NOISE, _mm_set1_ps(NOISESCALE)));
+            _mm_storeu_ps(out + k, _mm_mul_ps(SUM, CURVE));
+        }
+
+        offsetsScalar(job, s, k);
+    }
+}
+
+__attribute__((target("avx2"))) static __m256 sin8(__m256 x) {
+    const __m256 SIGNMASK = _mm256_set1_ps(-0.F);
+
+    x = _mm256_sub_ps(x,
+                      _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(0.5F / PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _mm256_set1_ps(2.F * PI)));
+
+    const __m256 SIGN = _mm256_and_ps(x, SIGNMASK);
+    __m256       a    = _mm256_andnot_ps(SIGNMASK, x);
+    a                 = _mm256_min_ps(a, _mm256_sub_ps(_mm256_set1_ps(PI), a));
+
+    const __m256 A2 = _mm256_mul_ps(a, a);
+    __m256       p  = _mm256_set1_ps(1.F / 362880.F);
+    p               = _mm256_add_ps(_mm256_mul_ps(p, A2), _mm256_set1_ps(-1.F / 5040.F));
+    p               = _mm256_add_ps(_mm256_mul_ps(p, A2), _mm256_set1_ps(1.F / 120.F));
+    p               = _mm256_add_ps(_mm256_mul_ps(p, A2), _mm256_set1_ps(-1.F / 6.F));
+    p               = _mm256_add_ps(_mm256_mul_ps(p, A2), _mm256_set1_ps(1.F));
+
+    return _mm256_xor_ps(_mm256_mul_ps(a, p), SIGN);
+}
+
+__attribute__((target("avx2"))) static __m256 noise8(__m256i x) {
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x7feb352d));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32((int)0x846ca68bU));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    return _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(x, 8)), _mm256_set1_ps(NOISEUNIT)), _mm256_set1_ps(1.F));
+}
+
+__attribute__((target("avx2"))) static void kernelAVX2(const SVineKernelJob& job) {
+    const __m256  STEP  = _mm256_set1_ps(WAVES / job.segments);
+    const __m256  CURVE = _mm256_set1_ps(job.curviness);
+    const __m256i IOTA  = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    for (size_t s = 0; s < job.count; ++s) {
+        const __m256  PHASE = _mm256_set1_ps(job.strands[s].phase);
+        const __m256i KEY   = _mm256_set1_epi32((int)(job.seed ^ (uint32_t)(s * 0x9E3779B9U)));
+        float*        out   = job.out + s * job.stride;
+
+        size_t        k = 0;
+        for (; k + 8 <= job.points; k += 8) {
+            const __m256i K     = _mm256_add_epi32(_mm256_set1_epi32((int)k), IOTA);
+            const __m256  WAVE  = sin8(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(K), STEP), PHASE));
+            const __m256  NOISE = noise8(_mm256_add_epi32(KEY, K));
+            const __m256  SUM   = _mm256_add_ps(_mm256_mul_ps(WAVE, _mm256_set1_ps(WAVESCALE)), _mm256_mul_ps(NOISE, _mm256_set1_ps(NOISESCALE)));
+            _mm256_storeu_ps(out + k, _mm256_mul_ps(SUM, CURVE));
+        }
+
+        offsetsScalar(job, s, k);
+    }
+}
+
+#endif
+
+using FVineKernel = void (*)(const SVineKernelJob&);
+
+static FVineKernel pickKernel() {
+#ifdef BPP_VINE_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return kernelAVX2;
+    if (__builtin_cpu_supports("sse4.1"))
+        return kernelSSE41;
+#endif
+    return kernelScalar;
+}
+
+void generateVineOffsets(const SVineKernelJob& job) {
+    static const FVineKernel KERNEL = pickKernel();
+
+    if (job.segments == 0)
+        return;
+
+    KERNEL(job);
+}
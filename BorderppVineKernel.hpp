@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "BorderppVineArena.hpp"
+
+// Computes the perpendicular offset of every grid point of a batch of strands:
+// a sine wave over the strand plus hash-based noise, both scaled by curviness.
+// out[s * stride + k] receives grid point k of strand s, for k < points
+struct SVineKernelJob {
+    const SVineStrand* strands   = nullptr;
+    size_t             count     = 0;
+    float*             out       = nullptr;
+    size_t             stride    = 0;
+    size_t             points    = 0;
+    size_t             segments  = 1;
+    float              curviness = 0;
+    uint32_t           seed      = 0;
+};
+
+// Runs the job on the widest SIMD lanes the CPU supports (AVX2, SSE4.1 or scalar)
+void generateVineOffsets(const SVineKernelJob& job);
+
+// Counter-based noise for grid point k of a strand, in [-1, 1)
+// Same value for the same (seed, strand, k), no state to share between strands
+inline float vineNoise(uint32_t seed, uint32_t strand, uint32_t k) {
+    uint32_t x = (seed ^ (strand * 0x9E3779B9U)) + k;
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return (float)(x >> 8) * (1.F / 8388608.F) - 1.F;
+}
+
+// Polynomial sine, within ~1e-5 of std::sin over the phases the vines use
+inline float vineFastSin(float x) {
+    constexpr float PI = 3.14159265358979F;
+
+    x -= std::nearbyint(x * (0.5F / PI)) * (2.F * PI);
+
+    // sin(|x|) == sin(pi - |x|), which folds [0, pi] onto [0, pi/2]
+    const float SIGN = x < 0 ? -1.F : 1.F;
+    float       a    = std::fabs(x);
+    a                = std::fmin(a, PI - a);
+
+    const float A2 = a * a;
+    return SIGN * a * (1.F + A2 * (-1.F / 6.F + A2 * (1.F / 120.F + A2 * (-1.F / 5040.F + A2 * (1.F / 362880.F)))));
+}
@@ -0,0 +1,245 @@
+#include "BorderppVineLibrary.hpp"
+#include "BorderppVineKernel.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// bump whenever the kernel or the template seeds change, older files are then ignored
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr char     CACHE_MAGIC[4] = {'B', 'P', 'P', 'V'};
+
+struct SCacheHeader {
+    char     magic[4] = {};
+    uint32_t version  = 0;
+    uint32_t count    = 0;
+    uint32_t pad      = 0;
+};
+
+struct SCacheRecord {
+    uint32_t strands  = 0;
+    uint32_t segments = 0;
+    uint32_t variant  = 0;
+    uint32_t seed     = 0;
+    uint64_t offset   = 0; // in floats, from the end of the records
+    uint64_t count    = 0;
+};
+
+static uint64_t templateKey(size_t strands, size_t segments, uint32_t variant) {
+    return ((uint64_t)strands << 40) | ((uint64_t)segments << 8) | variant;
+}
+
+static uint32_t templateSeed(uint32_t variant) {
+    return 0x9E3779B9U * (variant + 1);
+}
+
+static std::shared_ptr<SVineTemplate> makeTemplate(size_t strands, size_t segments, uint32_t variant) {
+    auto tmpl      = std::make_shared<SVineTemplate>();
+    tmpl->strands  = strands;
+    tmpl->segments = segments;
+    tmpl->seed     = templateSeed(variant);
+    tmpl->owned.resize(strands * (segments + 1));
+    tmpl->grid = tmpl->owned;
+
+    // the layout itself stands still, the renderer animates the sway
+    const std::vector<SVineStrand> SHAPES(strands);
+
+    generateVineOffsets({
+        .strands   = SHAPES.data(),
+        .count     = strands,
+        .out       = tmpl->owned.data(),
+        .stride    = segments + 1,
+        .points    = segments + 1,
+        .segments  = segments,
+        .curviness = 1.F,
+        .seed      = tmpl->seed,
+    });
+
+    return tmpl;
+}
+
+std::shared_ptr<const SVineTemplate> CBorderPPVineLibrary::get(size_t strands, size_t segments, uint32_t variant) {
+    variant %= VINE_TEMPLATE_VARIANTS;
+    const uint64_t KEY = templateKey(strands, segments, variant);
+
+    {
+        std::lock_guard lock(m_mutex);
+        if (const auto IT = m_mTemplates.find(KEY); IT != m_mTemplates.end()) {
+            if (auto tmpl = IT->second.lock())
+                return tmpl;
+        }
+
+        // an earlier run generated it, point into the mapping instead
+        if (const auto IT = m_mCache.find(KEY); IT != m_mCache.end()) {
+            auto tmpl      = std::make_shared<SVineTemplate>();
+            tmpl->strands  = strands;
+            tmpl->segments = segments;
+            tmpl->seed     = templateSeed(variant);
+            tmpl->grid     = {m_pCacheGrid + IT->second.offset, IT->second.count};
+            tmpl->backing  = m_pMapping;
+
+            m_mTemplates[KEY] = tmpl;
+            return tmpl;
+        }
+    }
+
+    // generated outside the lock so workers building other shapes don't wait;
+    // two racing for the same one both generate it, and the same values come out
+    auto tmpl = makeTemplate(strands, segments, variant);
+
+    std::lock_guard lock(m_mutex);
+    if (auto existing = m_mTemplates[KEY].lock())
+        return existing;
+
+    m_mTemplates[KEY] = tmpl;
+    std::erase_if(m_mTemplates, [](const auto& entry) { return entry.second.expired(); });
+
+    if (!m_szPath.empty()) {
+        m_mUnsaved[KEY] = tmpl;
+        m_bDirty        = true;
+    }
+
+    return tmpl;
+}
+
+size_t CBorderPPVineLibrary::open(const std::string& path) {
+    std::lock_guard lock(m_mutex);
+    return openLocked(path);
+}
+
+size_t CBorderPPVineLibrary::openLocked(const std::string& path) {
+    // templates mapped from the previous file keep it alive through their backing
+    m_szPath = path;
+    m_mCache.clear();
+    m_pMapping.reset();
+    m_pCacheGrid = nullptr;
+
+    const int FD = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD < 0)
+        return 0;
+
+    struct stat st = {};
+    const bool  OK = fstat(FD, &st) == 0 && (size_t)st.st_size >= sizeof(SCacheHeader);
+    void*       data = OK ? mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, FD, 0) : MAP_FAILED;
+    close(FD);
+
+    if (data == MAP_FAILED)
+        return 0;
+
+    const size_t SIZE = st.st_size;
+    // unmapped once the last template pointing into it is gone
+    m_pMapping = std::shared_ptr<const void>(data, [SIZE](const void* p) { munmap(const_cast<void*>(p), SIZE); });
+
+    SCacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const size_t RECORDSEND = sizeof(SCacheHeader) + (size_t)header.count * sizeof(SCacheRecord);
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION || RECORDSEND > SIZE) {
+        m_pMapping.reset();
+        return 0;
+    }
+
+    const auto*  RECORDS = (const SCacheRecord*)((const char*)data + sizeof(SCacheHeader));
+    const size_t FLOATS  = (SIZE - RECORDSEND) / sizeof(float);
+    m_pCacheGrid         = (const float*)((const char*)data + RECORDSEND);
+
+    // anything that doesn't add up is skipped, and generated again if needed
+    for (uint32_t i = 0; i < header.count; ++i) {
+        const auto& R = RECORDS[i];
+        if (R.variant >= VINE_TEMPLATE_VARIANTS || R.seed != templateSeed(R.variant) || R.count != (uint64_t)R.strands * (R.segments + 1) || R.offset > FLOATS ||
+            R.count > FLOATS - R.offset)
+            continue;
+
+        m_mCache[templateKey(R.strands, R.segments, R.variant)] = {.offset = R.offset, .count = R.count};
+    }
+
+    return m_mCache.size();
+}
+
+bool CBorderPPVineLibrary::save() {
+    std::lock_guard lock(m_mutex);
+
+    if (!m_bDirty || m_szPath.empty())
+        return true;
+
+    std::vector<SCacheRecord>         records;
+    std::vector<std::span<const float>> grids;
+    uint64_t                          offset = 0;
+
+    const auto                        ADD = [&](uint64_t key, std::span<const float> grid) {
+        const uint32_t STRANDS  = key >> 40;
+        const uint32_t SEGMENTS = (key >> 8) & 0xFFFFFFFF;
+        const uint32_t VARIANT  = key & 0xFF;
+
+        records.push_back({.strands = STRANDS, .segments = SEGMENTS, .variant = VARIANT, .seed = templateSeed(VARIANT), .offset = offset, .count = grid.size()});
+        grids.push_back(grid);
+        offset += grid.size();
+    };
+
+    for (const auto& [key, entry] : m_mCache) {
+        ADD(key, {m_pCacheGrid + entry.offset, entry.count});
+    }
+    for (const auto& [key, tmpl] : m_mUnsaved) {
+        if (!m_mCache.contains(key))
+            ADD(key, tmpl->grid);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(m_szPath).parent_path(), ec);
+
+    // written next to it and renamed over it, so a crash never leaves half a file and
+    // mappings of the old one stay valid
+    const std::string TMP  = m_szPath + ".tmp";
+    FILE*             file = std::fopen(TMP.c_str(), "wb");
+    if (!file)
+        return false;
+
+    SCacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.count   = records.size();
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok      = ok && std::fwrite(records.data(), sizeof(SCacheRecord), records.size(), file) == records.size();
+    for (const auto& grid : grids) {
+        ok = ok && std::fwrite(grid.data(), sizeof(float), grid.size(), file) == grid.size();
+    }
+
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(TMP.c_str(), m_szPath.c_str()) != 0) {
+        std::remove(TMP.c_str());
+        return false;
+    }
+
+    // the new file holds everything now, so the generated templates don't have to be kept
+    openLocked(m_szPath);
+    m_mUnsaved.clear();
+    m_bDirty = false;
+    return true;
+}
+
+bool CBorderPPVineLibrary::dirty() {
+    std::lock_guard lock(m_mutex);
+    return m_bDirty;
+}
+
+size_t CBorderPPVineLibrary::size() {
+    std::lock_guard lock(m_mutex);
+    std::erase_if(m_mTemplates, [](const auto& entry) { return entry.second.expired(); });
+    return m_mTemplates.size();
+}
+
+std::string vineCachePath() {
+    const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+    if (cacheHome && *cacheHome)
+        return std::string(cacheHome) + "/borders-plus-plus/vines.cache";
+
+    const char* home = std::getenv("HOME");
+    return std::string(home && *home ? home : "/tmp") + "/.cache/borders-plus-plus/vines.cache";
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "BorderppVineArena.hpp"
+
+// Distinct strand shapes per level of detail; an edge's seed picks one
+constexpr uint32_t VINE_TEMPLATE_VARIANTS = 8;
+
+// Plugin-wide store of vine templates. Edges laid out at the same level of detail
+// with the same variant share one template, so a grid of identically sized windows
+// generates its strand shapes once. Only the shapes are shared; each decoration still
+// maps and tessellates them into its own views. Templates live as long as some arena holds them.
+// With a cache file open, templates generated by an earlier run are mapped in from
+// it instead of generated again. Safe to use from the layout workers
+class CBorderPPVineLibrary {
+  public:
+    // The template for strands of segments each in variant, from the cache file or
+    // generated on first use
+    std::shared_ptr<const SVineTemplate> get(size_t strands, size_t segments, uint32_t variant);
+
+    // Maps the cache file at path in, if there is a valid one; save() writes there
+    // Returns the number of templates found in it
+    size_t                               open(const std::string& path);
+
+    // Writes every known template to the cache file when some were generated since it
+    // was last read or written, replacing it atomically, and maps the new file in.
+    // False if it couldn't be written
+    bool                                 save();
+
+    // True when save() has something to write
+    bool                                 dirty();
+
+    // Templates currently alive
+    size_t                               size();
+
+  private:
+    size_t                               openLocked(const std::string& path);
+
+    // where a template sits in the mapped cache file
+    struct SCacheEntry {
+        uint64_t offset = 0; // in floats, from the start of the grid data
+        size_t   count  = 0;
+    };
+
+    std::mutex                                                       m_mutex;
+    std::unordered_map<uint64_t, std::weak_ptr<const SVineTemplate>> m_mTemplates;
+
+    std::string                                                      m_szPath;
+    std::shared_ptr<const void>                                      m_pMapping; // of the cache file
+    const float*                                                     m_pCacheGrid = nullptr;
+    std::unordered_map<uint64_t, SCacheEntry>                        m_mCache;
+    // generated templates not in the cache file yet, kept until save() wrote them
+    std::unordered_map<uint64_t, std::shared_ptr<const SVineTemplate>> m_mUnsaved;
+    bool                                                             m_bDirty = false;
+};
+
+// Where the template cache lives: $XDG_CACHE_HOME, or ~/.cache without it
+std::string vineCachePath();
+
+inline CBorderPPVineLibrary g_borderPPVineLibrary;
@@ -0,0 +1,54 @@
+#include "BorderppVineWorker.hpp"
+
+#include <algorithm>
+
+CBorderPPVineWorker::CBorderPPVineWorker(unsigned threads, std::function<void()> onDone) : m_onDone(std::move(onDone)) {
+    if (threads == 0)
+        threads = std::clamp(std::thread::hardware_concurrency() / 2, 1U, VINE_WORKER_MAX_THREADS);
+
+    for (unsigned i = 0; i < threads; ++i) {
+        m_vThreads.emplace_back([this](std::stop_token stop) { run(stop); });
+    }
+}
+
+CBorderPPVineWorker::~CBorderPPVineWorker() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_queue.clear();
+    }
+
+    // jthreads request a stop, which wakes m_cv, and join
+    m_vThreads.clear();
+}
+
+void CBorderPPVineWorker::submit(std::shared_ptr<SVineBuild> build) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_queue.push_back(std::move(build));
+    }
+
+    m_cv.notify_one();
+}
+
+void CBorderPPVineWorker::run(std::stop_token stop) {
+    while (true) {
+        std::shared_ptr<SVineBuild> build;
+
+        {
+            std::unique_lock lock(m_mutex);
+            if (!m_cv.wait(lock, stop, [this] { return !m_queue.empty(); }))
+                return;
+
+            build = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        buildVineStrands(build->arena, build->lod, build->thickness, build->seed);
+        // the owner may swap the arena out as soon as it sees this, don't touch build after
+        build->done.store(true, std::memory_order_release);
+        build.reset();
+
+        if (m_onDone)
+            m_onDone();
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BorderppVines.hpp"
+
+// Most threads laying vines out in the background
+constexpr unsigned VINE_WORKER_MAX_THREADS = 4;
+
+// Small pool that lays vine strands out off the render thread.
+// Builds are handed over whole: a worker fills the build's arena, then
+// publishes it through its done flag and calls onDone from its own thread.
+class CBorderPPVineWorker {
+  public:
+    // threads 0 picks a share of the CPUs, up to VINE_WORKER_MAX_THREADS
+    explicit CBorderPPVineWorker(unsigned threads = 0, std::function<void()> onDone = {});
+    // Drops the builds not started yet and waits for the running ones
+    ~CBorderPPVineWorker();
+
+    // Queues build; it stays alive until the worker is done with it even if its owner goes away
+    void submit(std::shared_ptr<SVineBuild> build);
+
+  private:
+    void                                    run(std::stop_token stop);
+
+    std::function<void()>                   m_onDone;
+
+    std::mutex                              m_mutex;
+    std::condition_variable_any             m_cv;
+    std::deque<std::shared_ptr<SVineBuild>> m_queue;
+
+    std::vector<std::jthread>               m_vThreads;
+};
+
+// Set by the plugin; without it vines are laid out on the calling thread
+inline std::unique_ptr<CBorderPPVineWorker> g_pBorderPPVineWorker;
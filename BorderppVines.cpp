@@ -0,0 +1,600 @@
+#include "BorderppVines.hpp"
+#include "BorderppTrace.hpp"
+#include "BorderppVineWorker.hpp"
+#include "BorderppVineLibrary.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <utility>
+
+constexpr int    NUM_VINES = 3; // vine strands per side
+
+// level of detail, distances are in logical px and scaled to the monitor
+constexpr int    VINE_MIN_SEGMENTS  = 8;
+constexpr int    VINE_MAX_SEGMENTS  = 64;
+constexpr double VINE_POINT_SPACING = 8.0;  // between points, at least 2x the stem thickness
+constexpr double VINE_LEAF_SPACING  = 96.0; // between leaves, at least 2.5x the leaf size
+constexpr size_t LEAF_TRIANGLES     = 2;    // one instanced quad
+
+// animation: a wave travelling from the root to the tip, fading in near the root
+constexpr float  SWAY_AMPLITUDE  = 1.5F;  // times vine_thickness
+constexpr float  SWAY_ROOT       = 48.F;  // px from the root until the full sway
+constexpr float  SWAY_WAVENUMBER = 0.03F; // rad per px along the stem
+
+// Edges in growth order: top-left corner expands clockwise
+// top: left to right, right: top to bottom, bottom: right to left, left: bottom to top
+static std::array<SVineEdge, 4> vineEdges(const SBorderPPRect& box) {
+    const float X = box.x, Y = box.y, W = box.w, H = box.h;
+    return {{
+        {X, Y, 1, 0, W},
+        {X + W, Y, 0, 1, H},
+        {X + W, Y + H, -1, 0, W},
+        {X, Y + H, 0, -1, H},
+    }};
+}
+
+// How far strand i of an edge reaches for the edge's own progress, in edge parameter
+// Strand i starts at i/numVines of the edge and is fully grown at (i+1)/numVines
+static float strandLength(float edgeProgress, int i, int numVines) {
+    return std::clamp((edgeProgress * (i + 1) - i) / numVines, 0.F, 1.F / numVines);
+}
+
+// Sway of a point dist px along its stem: the amplitude and the wave's phase there
+static std::pair<float, float> swayAt(float dist, float sway) {
+    return {sway * std::min(dist / SWAY_ROOT, 1.F), -dist * SWAY_WAVENUMBER};
+}
+
+void appendStemStrip(std::vector<SStemVertex>& out, const SVinePath& path, float radius, float sway) {
+    if (path.count < 2)
+        return;
+
+    // one extra pixel so the antialiased edge is not cut off by the geometry
+    const float  EXTENT = radius + 1.F;
+    const bool   JOINED = !out.empty();
+    const size_t LAST   = path.count - 1;
+
+    // both vertices of a pair sway together, along the stem's normal there
+    float        dist = 0.F;
+    auto         push = [&](float x, float y, float nx, float ny, float scale, float along) {
+        const auto [AMP, PHASE] = swayAt(dist, sway);
+        out.push_back({x + nx * EXTENT * scale, y + ny * EXTENT * scale, EXTENT, along, nx * AMP, ny * AMP, PHASE});
+        out.push_back({x - nx * EXTENT * scale, y - ny * EXTENT * scale, -EXTENT, along, nx * AMP, ny * AMP, PHASE});
+    };
+
+    // normals are the path's precomputed tangents rotated by 90 degrees
+    const float CAPSTARTX = path.x[0] - path.tx[0] * EXTENT;
+    const float CAPSTARTY = path.y[0] - path.ty[0] * EXTENT;
+
+    // degenerate triangles to hop from the previous strip to this one
+    if (JOINED) {
+        out.push_back(out.back());
+        out.push_back({CAPSTARTX - path.ty[0] * EXTENT, CAPSTARTY + path.tx[0] * EXTENT, EXTENT, EXTENT});
+    }
+
+    push(CAPSTARTX, CAPSTARTY, -path.ty[0], path.tx[0], 1.F, EXTENT);
+
+    for (size_t i = 0; i < path.count; ++i) {
+        // miter: widen interior joins so the stem keeps its width through the bend
+        float scale = 1.F;
+        if (i > 0)
+            dist += std::hypot(path.x[i] - path.x[i - 1], path.y[i] - path.y[i - 1]);
+
+        if (i > 0 && i < LAST) {
+            const float DX  = path.x[i + 1] - path.x[i];
+            const float DY  = path.y[i + 1] - path.y[i];
+            const float LEN = std::sqrt(DX * DX + DY * DY);
+            if (LEN > 0.0001F)
+                scale = 1.F / std::max((path.tx[i] * DX + path.ty[i] * DY) / LEN, 0.5F);
+        }
+
+        push(path.x[i], path.y[i], -path.ty[i], path.tx[i], scale, 0.F);
+    }
+
+    push(path.x[LAST] + path.tx[LAST] * EXTENT, path.y[LAST] + path.ty[LAST] * EXTENT, -path.ty[LAST], path.tx[LAST], 1.F, EXTENT);
+}
+
+size_t vineTriangles(const SVineLOD& lod) {
+    // a strip of two vertices per point, the tip and the two caps, plus the joins between strips
+    const size_t POINTS = lod.segments + 2;
+    const size_t STEMS  = 4 * NUM_VINES * (2 * (POINTS + 2) + 2);
+    const size_t LEAVES = 4 * NUM_VINES * ((POINTS + lod.leafEvery - 1) / lod.leafEvery);
+
+    return STEMS + LEAVES * LEAF_TRIANGLES;
+}
+
+SVineLOD vineLodFor(double edgePx, int thickness, double scale, size_t budget) {
+    const double STRANDPX     = std::max(edgePx / NUM_VINES, 1.0);
+    const double POINTSPACING = std::max(VINE_POINT_SPACING, thickness * 2.0) * scale;
+    double       leafSpacing  = std::max(VINE_LEAF_SPACING * scale, thickness * 4.0 * 2.5);
+
+    SVineLOD     lod;
+    lod.segments  = std::clamp((int)std::round(STRANDPX / POINTSPACING), VINE_MIN_SEGMENTS, VINE_MAX_SEGMENTS);
+    auto leafEveryFor = [&] { return std::max(1, (int)std::round(leafSpacing / (STRANDPX / lod.segments))); };
+    lod.leafEvery     = leafEveryFor();
+
+    // over budget: take away from whichever of stems and leaves costs more
+    while (budget > 0 && vineTriangles(lod) > budget) {
+        const size_t TOTAL      = vineTriangles(lod);
+        const size_t LEAVES     = TOTAL - vineTriangles({.segments = lod.segments, .leafEvery = lod.segments + 2});
+        const bool   CANTHIN    = lod.leafEvery < lod.segments + 2;
+        const bool   CANCOARSEN = lod.segments > VINE_MIN_SEGMENTS;
+
+        if (CANTHIN && (LEAVES * 2 >= TOTAL || !CANCOARSEN))
+            leafSpacing *= 1.5;
+        else if (CANCOARSEN)
+            lod.segments = std::max(VINE_MIN_SEGMENTS, lod.segments * 4 / 5);
+        else
+            break;
+
+        lod.leafEvery = std::min(leafEveryFor(), lod.segments + 2);
+    }
+
+    return lod;
+}
+
+void CBorderPPVines::update(const SBorderPPRect& box, double scale, float growth, int thickness, uint64_t configGeneration, size_t primitiveBudget,
+                            uint64_t view) {
+    collectLayout();
+
+    const bool RELAYOUT = !m_bLaidOut || m_iConfigGeneration != configGeneration || growth < m_fGrowth || needsRelayout(box, scale);
+
+    // a fresh layout forgets the monitors the window has left
+    if (RELAYOUT) {
+        for (auto& v : m_views) {
+            v.used = false;
+        }
+    }
+
+    m_iView = &viewFor(view, scale) - m_views.data();
+
+    double lodScale = 0;
+    for (const auto& v : m_views) {
+        if (v.used)
+            lodScale = std::max(lodScale, v.scale);
+    }
+
+    // the level of detail follows the on-screen size, with a band so resizes don't flicker
+    const double EDGEPX      = std::max(box.w, box.h) / scale * lodScale;
+    bool         newSegments = false;
+    if (RELAYOUT || needsNewLod(EDGEPX, lodScale)) {
+        const auto LOD = vineLodFor(EDGEPX, thickness, lodScale, primitiveBudget);
+        newSegments    = LOD.segments != m_lod.segments;
+        m_lod          = LOD;
+        m_fLodEdgePx   = EDGEPX;
+        m_fLodScale    = lodScale;
+    }
+
+    // lay the strands out again only when the topology has to change: config reload,
+    // the midnight reset, the box changing size past the hysteresis band, or a new
+    // segment count. The seed is fixed, so the same window gets the same vines every time
+    if (RELAYOUT || newSegments) {
+        m_iConfigGeneration = configGeneration;
+        generate(box, scale, thickness);
+    }
+
+    // otherwise only extend the tips (every 1% step or ~10 minutes)
+    if (growth != m_fGrowth)
+        this->grow(growth);
+
+    // moves and resizes only remap the existing paths, in place
+    if (auto& v = *currentView(); !v.mapped || box != v.box) {
+        m_arena.map(v.mapping, vineEdges(box), scale);
+        v.box    = box;
+        v.mapped = true;
+        v.stemVertices.clear();
+    }
+}
+
+// Returns the cached view for id at scale. A monitor takes over its old view, even one
+// a relayout let go of or at another scale, others recycle an unused or the least
+// recently used one; a taken over or recycled view keeps its buffers but has to be
+// mapped again
+SVineView& CBorderPPVines::viewFor(uint64_t id, double scale) {
+    SVineView* pick = &m_views[0];
+    for (auto& v : m_views) {
+        if (v.lastUse > 0 && v.id == id) {
+            pick = &v;
+            break;
+        }
+
+        if ((!v.used && pick->used) || (v.used == pick->used && v.lastUse < pick->lastUse))
+            pick = &v;
+    }
+
+    if (!pick->used || pick->id != id || pick->scale != scale) {
+        pick->id     = id;
+        pick->scale  = scale;
+        pick->used   = true;
+        pick->mapped = false;
+        pick->stemVertices.clear();
+    }
+
+    pick->lastUse = ++m_iUseClock;
+    return *pick;
+}
+
+// Each strand gets its random offsets once, growth and resizes reuse them
+// The arena keeps its buffers, so this only allocates the first time
+void buildVineStrands(CBorderPPVineArena& arena, const SVineLOD& lod, int thickness, uint32_t seed) {
+    BPP_TRACE_ZONE("generateVinePath");
+
+    arena.reset(4 * NUM_VINES, lod.segments);
+
+    for (uint32_t edge = 0; edge < 4; ++edge) {
+        for (int i = 0; i < NUM_VINES; ++i) {
+            // the sway is animated by the renderer, the layout itself stands still
+            arena.addStrand(edge, (float)i / NUM_VINES, 1.F / NUM_VINES, 0.F);
+        }
+    }
+
+    // the shapes come from the shared library, each edge's seed only picks and turns one
+    std::array<SVineEdgeShape, 4> shapes;
+    for (uint32_t edge = 0; edge < 4; ++edge) {
+        const uint32_t EDGESEED = vineEdgeSeed(seed, edge);
+        shapes[edge]            = {.tmpl = g_borderPPVineLibrary.get(NUM_VINES, lod.segments, EDGESEED % VINE_TEMPLATE_VARIANTS), .mirror = ((EDGESEED >> 8) & 1) != 0};
+    }
+
+    arena.generate(shapes, thickness * 0.5F);
+}
+
+uint32_t vineSeedFor(std::string_view windowClass) {
+    // FNV-1a
+    uint32_t hash = 2166136261U;
+    for (const char c : windowClass) {
+        hash = (hash ^ (uint8_t)c) * 16777619U;
+    }
+    return hash;
+}
+
+uint32_t vineEdgeSeed(uint32_t seed, uint32_t edge) {
+    uint32_t x = seed ^ ((edge + 1) * 0x9E3779B9U);
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+void CBorderPPVines::setSeed(uint32_t seed) {
+    if (seed == m_iSeed)
+        return;
+
+    // the next update() lays the strands out again with it
+    m_iSeed    = seed;
+    m_bLaidOut = false;
+}
+
+void CBorderPPVines::generate(const SBorderPPRect& box, double scale, int thickness) {
+    m_iThickness = thickness;
+    m_fLayoutW   = box.w / scale;
+    m_fLayoutH   = box.h / scale;
+    m_bLaidOut   = true;
+
+    layOut();
+}
+
+// Lays the strands out for the current LOD and seed, in the background when there is a
+// worker; until then the previous layout keeps being grown and drawn
+void CBorderPPVines::layOut() {
+    if (!g_pBorderPPVineWorker) {
+        buildVineStrands(m_arena, m_lod, m_iThickness, m_iSeed);
+        finishLayout();
+        return;
+    }
+
+    // one build at a time per decoration, the newest request goes next
+    if (m_bBuilding) {
+        m_bRebuild = true;
+        return;
+    }
+
+    if (!m_pBuild)
+        m_pBuild = std::make_shared<SVineBuild>();
+
+    m_pBuild->lod       = m_lod;
+    m_pBuild->thickness = m_iThickness;
+    m_pBuild->seed      = m_iSeed;
+    m_pBuild->done.store(false, std::memory_order_relaxed);
+    m_bBuilding = true;
+
+    g_pBorderPPVineWorker->submit(m_pBuild);
+}
+
+// Swaps in a finished background layout, or starts the one asked for since
+void CBorderPPVines::collectLayout() {
+    if (!layoutReady())
+        return;
+
+    m_bBuilding = false;
+
+    if (m_bRebuild) {
+        m_bRebuild = false;
+        layOut();
+        return;
+    }
+
+    std::swap(m_arena, m_pBuild->arena);
+    finishLayout();
+}
+
+// A new layout starts ungrown and has to be mapped into every view again
+void CBorderPPVines::finishLayout() {
+    m_fGrowth = -1.F;
+    for (auto& v : m_views) {
+        v.mapped = false;
+        v.stemVertices.clear();
+    }
+
+    m_bGenerated = true;
+    m_iRegenerations++;
+}
+
+// Returns true when the box outgrew (or shrank away from) the layout the strands
+// were generated for, past the hysteresis band; smaller changes are only remapped
+bool CBorderPPVines::needsRelayout(const SBorderPPRect& box, double scale) const {
+    const double RATIOX = (box.w / scale) / m_fLayoutW;
+    const double RATIOY = (box.h / scale) / m_fLayoutH;
+
+    return RATIOX > VINE_RELAYOUT_RATIO || RATIOX < 1.0 / VINE_RELAYOUT_RATIO || RATIOY > VINE_RELAYOUT_RATIO || RATIOY < 1.0 / VINE_RELAYOUT_RATIO;
+}
+
+// Returns true when the longest edge changed past the LOD hysteresis band, or the scale changed
+bool CBorderPPVines::needsNewLod(double edgePx, double scale) const {
+    return scale != m_fLodScale || edgePx > m_fLodEdgePx * VINE_LOD_HYSTERESIS || edgePx < m_fLodEdgePx / VINE_LOD_HYSTERESIS;
+}
+
+std::optional<SBorderPPRect> CBorderPPVines::grow(float growth) {
+    const size_t NUMVINES = m_arena.strands() / 4;
+
+    double       minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (size_t idx = 0; idx < m_arena.strands(); ++idx) {
+        const auto& STRAND = m_arena.strand(idx);
+
+        // each edge takes a quarter of the day's growth
+        const float EDGEPROGRESS = std::clamp((growth - STRAND.edge * 0.25F) * 4.F, 0.F, 1.F);
+        const float LENGTH       = strandLength(EDGEPROGRESS, idx % NUMVINES, NUMVINES);
+
+        if (LENGTH <= STRAND.length)
+            continue;
+
+        // new points are mapped onto the box of every view right away
+        const size_t FIRST = m_arena.growStrand(idx, LENGTH);
+        for (auto& v : m_views) {
+            if (v.mapped)
+                m_arena.mapGrown(v.mapping, idx, FIRST);
+        }
+
+        const auto* VIEW = currentView();
+        if (!VIEW || !VIEW->mapped)
+            continue;
+
+        const auto PATH = m_arena.path(VIEW->mapping, idx);
+        for (size_t i = FIRST; i < PATH.count; ++i) {
+            minX = std::min(minX, (double)PATH.x[i]);
+            minY = std::min(minY, (double)PATH.y[i]);
+            maxX = std::max(maxX, (double)PATH.x[i]);
+            maxY = std::max(maxY, (double)PATH.y[i]);
+        }
+    }
+
+    m_fGrowth = growth;
+
+    if (minX > maxX)
+        return std::nullopt;
+
+    for (auto& v : m_views) {
+        v.stemVertices.clear();
+    }
+
+    return SBorderPPRect{minX, minY, maxX - minX, maxY - minY};
+}
+
+// Tessellates every strand into the view's stem strip and splits each strip into
+// chunks of STEM_CHUNK_POINTS points with their bounds (swayed as far as they go), for culling
+void CBorderPPVines::tessellate(SVineView& view, float radius, float sway) {
+    view.stemVertices.clear();
+    view.stemChunks.clear();
+    view.stemStrands.assign(m_arena.strands(), {});
+    view.stemRadius = radius;
+    view.stemSway   = sway;
+
+    // each strand becomes a strip of two vertices per point, plus caps and the joins between strips
+    view.stemVertices.reserve(4 * NUM_VINES * (2 * (m_lod.segments + 2) + 6));
+
+    double minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+
+    for (size_t idx = 0; idx < m_arena.strands(); ++idx) {
+        const size_t BEFORE = view.stemVertices.size();
+        appendStemStrip(view.stemVertices, m_arena.path(view.mapping, idx), radius, sway);
+        if (view.stemVertices.size() == BEFORE)
+            continue;
+
+        // the strip proper starts after the two vertices joining it to the previous one;
+        // chunks share their boundary pair so that drawing two neighbours leaves no gap
+        const size_t FIRST = BEFORE == 0 ? 0 : BEFORE + 2;
+        const size_t PAIRS = (view.stemVertices.size() - FIRST) / 2;
+        auto&        strand = view.stemStrands[idx];
+        strand.firstChunk   = view.stemChunks.size();
+
+        double sMinX = INFINITY, sMinY = INFINITY, sMaxX = -INFINITY, sMaxY = -INFINITY;
+        for (size_t pair = 0; pair + 1 < PAIRS; pair += STEM_CHUNK_POINTS) {
+            const size_t LASTPAIR = std::min(pair + STEM_CHUNK_POINTS, PAIRS - 1);
+            SStemChunk   chunk    = {.first = (uint32_t)(FIRST + pair * 2), .count = (uint32_t)((LASTPAIR - pair + 1) * 2), .bounds = {}};
+
+            double       cMinX = INFINITY, cMinY = INFINITY, cMaxX = -INFINITY, cMaxY = -INFINITY;
+            for (size_t v = chunk.first; v < chunk.first + chunk.count; ++v) {
+                cMinX = std::min(cMinX, (double)view.stemVertices[v].x);
+                cMinY = std::min(cMinY, (double)view.stemVertices[v].y);
+                cMaxX = std::max(cMaxX, (double)view.stemVertices[v].x);
+                cMaxY = std::max(cMaxY, (double)view.stemVertices[v].y);
+            }
+            chunk.bounds = SBorderPPRect{cMinX, cMinY, cMaxX - cMinX, cMaxY - cMinY}.expanded(sway);
+            cMinX -= sway;
+            cMinY -= sway;
+            cMaxX += sway;
+            cMaxY += sway;
+
+            sMinX = std::min(sMinX, cMinX);
+            sMinY = std::min(sMinY, cMinY);
+            sMaxX = std::max(sMaxX, cMaxX);
+            sMaxY = std::max(sMaxY, cMaxY);
+            view.stemChunks.push_back(chunk);
+        }
+
+        strand.chunks = view.stemChunks.size() - strand.firstChunk;
+        strand.bounds = {sMinX, sMinY, sMaxX - sMinX, sMaxY - sMinY};
+
+        minX = std::min(minX, sMinX);
+        minY = std::min(minY, sMinY);
+        maxX = std::max(maxX, sMaxX);
+        maxY = std::max(maxY, sMaxY);
+    }
+
+    view.stemBounds = view.stemVertices.empty() ? SBorderPPRect{} : SBorderPPRect{minX, minY, maxX - minX, maxY - minY};
+}
+
+// Gathers the strands and chunks of view that touch viewport into m_vVisibleStems,
+// neighbouring runs merged and the rest joined by degenerate triangles
+void CBorderPPVines::cullStems(const SVineView& view, const SBorderPPRect& viewport) {
+    m_vVisibleStems.clear();
+
+    size_t runFirst = 0, runEnd = 0;
+    auto   flush = [&] {
+        if (runEnd == runFirst)
+            return;
+
+        if (!m_vVisibleStems.empty()) {
+            m_vVisibleStems.push_back(m_vVisibleStems.back());
+            m_vVisibleStems.push_back(view.stemVertices[runFirst]);
+        }
+
+        m_vVisibleStems.insert(m_vVisibleStems.end(), view.stemVertices.begin() + runFirst, view.stemVertices.begin() + runEnd);
+        runFirst = runEnd = 0;
+    };
+
+    auto add = [&](size_t first, size_t end) {
+        // chunks of one strand overlap by a pair, so consecutive ones extend the run
+        if (runEnd != runFirst && first <= runEnd) {
+            runEnd = std::max(runEnd, end);
+            return;
+        }
+
+        flush();
+        runFirst = first;
+        runEnd   = end;
+    };
+
+    for (const auto& STRAND : view.stemStrands) {
+        if (STRAND.chunks == 0 || !viewport.intersects(STRAND.bounds))
+            continue;
+
+        const auto& FIRSTCHUNK = view.stemChunks[STRAND.firstChunk];
+        const auto& LASTCHUNK  = view.stemChunks[STRAND.firstChunk + STRAND.chunks - 1];
+
+        if (viewport.contains(STRAND.bounds)) {
+            add(FIRSTCHUNK.first, LASTCHUNK.first + LASTCHUNK.count);
+            continue;
+        }
+
+        for (uint32_t c = 0; c < STRAND.chunks; ++c) {
+            const auto& CHUNK = view.stemChunks[STRAND.firstChunk + c];
+            if (viewport.intersects(CHUNK.bounds))
+                add(CHUNK.first, CHUNK.first + CHUNK.count);
+        }
+    }
+
+    flush();
+}
+
+void CBorderPPVines::draw(IBorderPPRenderer& renderer, const SBorderPPColor& color, float a, int thickness, float time, bool animate) {
+    // tessellate all stems into one strip whenever the paths, thickness or animation changed
+    auto&       view       = *currentView();
+    const float STEMRADIUS = thickness * 0.4F;
+    const float SWAY       = animate ? thickness * SWAY_AMPLITUDE : 0.F;
+    if (view.stemVertices.empty() || view.stemRadius != STEMRADIUS || view.stemSway != SWAY)
+        tessellate(view, STEMRADIUS, SWAY);
+
+    // all stems in a single call, slightly darkened; only what reaches the screen
+    // when the window hangs off the monitor
+    const auto                   VIEWPORT = renderer.viewport();
+    std::span<const SStemVertex> stems    = view.stemVertices;
+    SBorderPPRect                bounds   = view.stemBounds;
+    if (!VIEWPORT.contains(view.stemBounds)) {
+        cullStems(view, VIEWPORT);
+        stems = m_vVisibleStems;
+
+        const double X1 = std::max(bounds.x, VIEWPORT.x), Y1 = std::max(bounds.y, VIEWPORT.y);
+        const double X2 = std::min(bounds.x + bounds.w, VIEWPORT.x + VIEWPORT.w), Y2 = std::min(bounds.y + bounds.h, VIEWPORT.y + VIEWPORT.h);
+        bounds          = {X1, Y1, std::max(X2 - X1, 0.0), std::max(Y2 - Y1, 0.0)};
+    }
+
+    const SBorderPPColor STEMCOLOR = {color.r * 0.8F, color.g * 0.9F, color.b * 0.8F, a};
+    if (!stems.empty())
+        renderer.drawStems(stems, bounds, STEMCOLOR, STEMRADIUS, time);
+
+    // larger decorative leaves at the interval the LOD picked, slightly transparent,
+    // swaying a little and all in one batch
+    const float          LEAFSIZE  = thickness * 4.F;
+    const SBorderPPColor LEAFCOLOR = {color.r, color.g, color.b, a * 0.8F};
+
+    m_vLeaves.clear();
+    double minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+
+    for (size_t idx = 0; idx < m_arena.strands(); ++idx) {
+        const auto PATH = m_arena.path(view.mapping, idx);
+        if (PATH.count < 2 || !VIEWPORT.intersects(view.stemStrands[idx].bounds.expanded(LEAFSIZE)))
+            continue;
+
+        float  dist = 0.F;
+        size_t last = 0;
+        for (size_t i = 0; i < PATH.count; i += m_lod.leafEvery) {
+            for (; last < i; ++last) {
+                dist += std::hypot(PATH.x[last + 1] - PATH.x[last], PATH.y[last + 1] - PATH.y[last]);
+            }
+
+            // offset perpendicular to the vine, alternating sides
+            const float SIDE = (i / m_lod.leafEvery) % 2 == 0 ? 1.F : -1.F;
+            const float X    = PATH.x[i] - PATH.ty[i] * SIDE * LEAFSIZE * 0.5F;
+            const float Y    = PATH.y[i] + PATH.tx[i] * SIDE * LEAFSIZE * 0.5F;
+
+            // swaying with the stem point it grows from
+            const auto [AMP, PHASE] = swayAt(dist, SWAY);
+            m_vLeaves.push_back({.x         = X,
+                                 .y         = Y,
+                                 .size      = LEAFSIZE,
+                                 .spin      = i * 0.5F,
+                                 .swayX     = -PATH.ty[i] * AMP,
+                                 .swayY     = PATH.tx[i] * AMP,
+                                 .swayPhase = PHASE,
+                                 .color     = LEAFCOLOR});
+
+            minX = std::min(minX, (double)X);
+            minY = std::min(minY, (double)Y);
+            maxX = std::max(maxX, (double)X);
+            maxY = std::max(maxY, (double)Y);
+        }
+    }
+
+    // a leaf reaches at most LEAFSIZE from its anchor, whichever way it is rotated
+    if (!m_vLeaves.empty())
+        renderer.drawLeaves(m_vLeaves, SBorderPPRect{minX, minY, maxX - minX, maxY - minY}.expanded(LEAFSIZE + SWAY), time);
+}
+
+std::span<const SBorderPPRect> CBorderPPVines::animatedBounds(int thickness) {
+    m_vAnimatedBounds.clear();
+    const auto* VIEW = currentView();
+    if (!VIEW || VIEW->stemVertices.empty())
+        return {};
+
+    // the leaves stick out of the strips by up to VINE_LEAF_MARGIN (their anchor sits
+    // half a leaf off the stem), and sway on top of that
+    const double MARGIN = thickness * (VINE_LEAF_MARGIN + SWAY_AMPLITUDE);
+    for (const auto& STRAND : VIEW->stemStrands) {
+        if (STRAND.chunks > 0)
+            m_vAnimatedBounds.push_back(STRAND.bounds.expanded(MARGIN));
+    }
+
+    return m_vAnimatedBounds;
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "BorderppCore.hpp"
+#include "BorderppVineArena.hpp"
+
+// Box size change (either way) past which strands are laid out again instead of remapped
+constexpr double VINE_RELAYOUT_RATIO = 2.0;
+// Edge length change (either way) past which the level of detail is picked again,
+// so it doesn't flip back and forth while a window is resized around a threshold
+constexpr double VINE_LOD_HYSTERESIS = 1.25;
+// Triangles the vines of one decoration may cost, the vine_primitive_budget default
+constexpr size_t VINE_DEFAULT_PRIMITIVE_BUDGET = 4000;
+// Monitors (at a scale) one decoration keeps mapped geometry for
+constexpr size_t VINE_VIEW_CACHE_SIZE = 4;
+
+// How finely the vines of one decoration are built
+struct SVineLOD {
+    int  segments  = 0; // grid segments per strand
+    int  leafEvery = 1; // a leaf on every n-th point of a strand
+
+    bool operator==(const SVineLOD&) const = default;
+};
+
+// Points per culling chunk of a stem strip
+constexpr size_t STEM_CHUNK_POINTS = 8;
+
+// A run of the tessellated stems that is culled as a whole
+struct SStemChunk {
+    uint32_t      first = 0; // vertex range in the strip
+    uint32_t      count = 0;
+    SBorderPPRect bounds;
+};
+
+// The chunks of one strand's stem strip, and their bounds
+struct SStemStrand {
+    uint32_t      firstChunk = 0;
+    uint32_t      chunks     = 0;
+    SBorderPPRect bounds;
+};
+
+// The vines mapped and tessellated for one monitor at one scale
+struct SVineView {
+    uint64_t                 id       = 0;
+    double                   scale    = 1.0;
+    uint64_t                 lastUse  = 0;
+    bool                     used     = false;
+    bool                     mapped   = false;
+
+    // box the paths are mapped onto, in pixels
+    SBorderPPRect            box;
+    SVineMapping             mapping;
+
+    std::vector<SStemVertex> stemVertices;
+    SBorderPPRect            stemBounds;
+    float                    stemRadius = 0.F;
+    float                    stemSway   = 0.F;
+    // culling: chunks of every strand's strip in order, and per strand its chunks and bounds
+    std::vector<SStemChunk>  stemChunks;
+    std::vector<SStemStrand> stemStrands;
+};
+
+// Picks the level of detail for vines along edges up to edgePx physical pixels long:
+// points a fixed on-screen distance apart and leaves a fixed distance apart, coarsened
+// until the estimated triangles fit budget (0 for no limit)
+SVineLOD vineLodFor(double edgePx, int thickness, double scale, size_t budget);
+
+// Triangles the vines of a decoration cost at lod once fully grown
+size_t   vineTriangles(const SVineLOD& lod);
+
+// One layout of the strands, built away from the render thread and handed back whole
+struct SVineBuild {
+    SVineLOD           lod;
+    int                thickness = 0;
+    uint32_t           seed      = 0;
+
+    CBorderPPVineArena arena;
+    std::atomic<bool>  done = false; // arena is complete, set by whoever built it
+};
+
+// Seed of the vines of a window, so windows of one class grow the same vines every time
+uint32_t vineSeedFor(std::string_view windowClass);
+
+// Seed of one edge (0 top, 1 right, 2 bottom, 3 left) of the vines grown from seed
+uint32_t vineEdgeSeed(uint32_t seed, uint32_t edge);
+
+// Lays out all strands at lod into arena, for a stem thickness and seed
+// Touches nothing but arena and the thread-safe template library, so it can run on any thread
+void buildVineStrands(CBorderPPVineArena& arena, const SVineLOD& lod, int thickness, uint32_t seed);
+
+// Appends one stem as a triangle strip to out, joined to any previous
+// strip by degenerate triangles so all stems can be drawn in one call.
+// sway is how far the stem swings across when animated, in pixels
+void appendStemStrip(std::vector<SStemVertex>& out, const SVinePath& path, float radius, float sway = 0.F);
+
+// The vines of one decoration: lays the strands out, grows them with the time
+// of day, maps them onto the box they are drawn around and emits their primitives.
+// The strands are shared, the mapped geometry is kept per view (a monitor at a
+// scale), so a window spanning monitors of different scales draws on each
+// without remapping in between. With g_pBorderPPVineWorker set, new layouts are
+// built in the background while the previous one keeps being drawn.
+class CBorderPPVines {
+  public:
+    CBorderPPVines() = default;
+    // a copy would share the background build with the original, moving hands it over
+    CBorderPPVines(const CBorderPPVines&)            = delete;
+    CBorderPPVines& operator=(const CBorderPPVines&) = delete;
+    CBorderPPVines(CBorderPPVines&&)                 = default;
+    CBorderPPVines& operator=(CBorderPPVines&&)      = default;
+
+    // Brings the vines up to date for box (in pixels) on view at scale. Strands are only
+    // laid out again on config reloads, the midnight reset, large size changes and level of
+    // detail changes; otherwise the tips are grown and the paths remapped.
+    // Picks up a finished background layout first
+    void update(const SBorderPPRect& box, double scale, float growth, int thickness, uint64_t configGeneration,
+                size_t primitiveBudget = VINE_DEFAULT_PRIMITIVE_BUDGET, uint64_t view = 0);
+
+    // Sets the seed the strands are laid out from, see vineSeedFor(); a new one lays them out again
+    void setSeed(uint32_t seed);
+
+    // Grows the strands to growth in every view
+    // Returns the bounding box of what changed in the view of the last update(), if anything
+    std::optional<SBorderPPRect> grow(float growth);
+
+    // Emits the stems in one batch and the leaves in another, skipping strands and
+    // runs of segments outside the renderer's viewport. With animate the geometry
+    // carries its sway and the renderer moves it for time; it only changes when
+    // animate is toggled
+    void                         draw(IBorderPPRenderer& renderer, const SBorderPPColor& color, float a, int thickness, float time = 0.F, bool animate = false);
+
+    // What changes between animation frames, in pixels of the last draw()'s view:
+    // every drawn strand's strip and leaves with their sway. Empty before a draw
+    std::span<const SBorderPPRect> animatedBounds(int thickness);
+
+    // True when a background layout finished and the next update() will swap it in
+    bool layoutReady() const {
+        return m_bBuilding && m_pBuild->done.load(std::memory_order_acquire);
+    }
+
+    // True once the vines were laid out and mapped onto a box in the view of the last update()
+    bool ready() const {
+        return m_bGenerated && currentView() && currentView()->mapped;
+    }
+
+    // Growth the strands were last grown to, -1 right after a layout
+    float growth() const {
+        return m_fGrowth;
+    }
+
+    // How many times the strands were laid out from scratch
+    uint64_t regenerations() const {
+        return m_iRegenerations;
+    }
+
+    const SVineLOD& lod() const {
+        return m_lod;
+    }
+
+  private:
+    void                     generate(const SBorderPPRect& box, double scale, int thickness);
+    void                     layOut();
+    void                     collectLayout();
+    void                     finishLayout();
+    bool                     needsRelayout(const SBorderPPRect& box, double scale) const;
+    bool                     needsNewLod(double edgePx, double scale) const;
+    SVineView&               viewFor(uint64_t id, double scale);
+
+    // the view of the last update(), if any
+    SVineView* currentView() {
+        return m_iView ? &m_views[*m_iView] : nullptr;
+    }
+
+    const SVineView* currentView() const {
+        return m_iView ? &m_views[*m_iView] : nullptr;
+    }
+
+    void                     tessellate(SVineView& view, float radius, float sway);
+    void                     cullStems(const SVineView& view, const SBorderPPRect& viewport);
+
+    CBorderPPVineArena       m_arena;
+    bool                     m_bLaidOut   = false; // a layout was asked for, maybe still building
+    bool                     m_bGenerated = false; // m_arena holds a layout
+
+    // least recently used views are recycled, keeping their buffers
+    std::array<SVineView, VINE_VIEW_CACHE_SIZE> m_views;
+
+    // the background layout; its arena is swapped with m_arena when done, so both keep their buffers
+    std::shared_ptr<SVineBuild> m_pBuild;
+    bool                     m_bBuilding = false;
+    bool                     m_bRebuild  = false; // laid out again while building, the result is stale
+    std::optional<size_t>    m_iView; // of the last update(), an index so moving the vines keeps it valid
+    uint64_t                 m_iUseClock = 0;
+
+    // logical box size the strands were laid out for
+    double                   m_fLayoutW         = 0;
+    double                   m_fLayoutH         = 0;
+    uint64_t                 m_iConfigGeneration = 0;
+    float                    m_fGrowth           = -1.F;
+    uint64_t                 m_iRegenerations    = 0;
+    uint32_t                 m_iSeed             = 0;
+    int                      m_iThickness        = 0;
+
+    // picked for the longest edge at the largest scale among the views, so every
+    // monitor gets enough detail and moving between them doesn't lay the strands out again
+    SVineLOD                 m_lod;
+    double                   m_fLodEdgePx = 0;
+    double                   m_fLodScale  = 0;
+
+    // the visible part of a view's stems, when some of it is off screen
+    std::vector<SStemVertex> m_vVisibleStems;
+    // leaves of the current draw, refilled every draw
+    std::vector<SLeafInstance> m_vLeaves;
+    std::vector<SBorderPPRect> m_vAnimatedBounds;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../BorderppCore.hpp"
+
+#include <vector>
+
+// Counts what the core asks to draw instead of drawing it.
+// Damage works like CBorderPPRenderer's: with fullDamage off, only
+// primitives touching one of the damage rects count as drawn.
+class CRecordingRenderer : public IBorderPPRenderer {
+  public:
+    virtual void drawRings(const SBorderPPRect& box, std::span<const SBorderRing> rings, float, float) {
+        if (rings.empty() || !touchesDamage(box.expanded(rings.back().outer + 1.F)))
+            return;
+
+        drawCalls++;
+        this->rings += rings.size();
+    }
+
+    virtual void drawStems(std::span<const SStemVertex> verts, const SBorderPPRect& bounds, const SBorderPPColor&, float, float) {
+        if (verts.size() < 3 || !touchesDamage(bounds))
+            return;
+
+        drawCalls++;
+        stemVertices += verts.size();
+    }
+
+    virtual void drawLeaves(std::span<const SLeafInstance> leaves, const SBorderPPRect& bounds, float) {
+        if (leaves.empty() || !touchesDamage(bounds))
+            return;
+
+        drawCalls++;
+        this->leaves += leaves.size();
+    }
+
+    virtual bool isDamaged(const SBorderPPRect& outer, const SBorderPPRect& inner = {}) {
+        if (fullDamage)
+            return true;
+
+        for (const auto& r : damage) {
+            const bool TOUCHESOUTER = r.x < outer.x + outer.w && r.x + r.w > outer.x && r.y < outer.y + outer.h && r.y + r.h > outer.y;
+            const bool INSIDEINNER  = !inner.empty() && r.x >= inner.x && r.x + r.w <= inner.x + inner.w && r.y >= inner.y && r.y + r.h <= inner.y + inner.h;
+            if (TOUCHESOUTER && !INSIDEINNER)
+                return true;
+        }
+
+        return false;
+    }
+
+    virtual SBorderPPRect viewport() {
+        return view;
+    }
+
+    void reset() {
+        drawCalls = rings = stemVertices = leaves = 0;
+    }
+
+    bool                       fullDamage = true;
+    std::vector<SBorderPPRect> damage; // in pixels, only used without fullDamage
+    SBorderPPRect              view = UNBOUNDED_VIEWPORT;
+
+    size_t                     drawCalls = 0, rings = 0, stemVertices = 0, leaves = 0;
+
+  private:
+    bool touchesDamage(const SBorderPPRect& box) {
+        return isDamaged(box);
+    }
+};
@@ -0,0 +1,196 @@
+// Headless benchmark for the compositor-independent core: vine generation,
+// growth, ring layout and primitive emission, without a GPU or a compositor.
+//
+// For every combination of window count, window size, vine_thickness and
+// add_borders it reports the time to lay out all vines from scratch and again
+// after a config reload, the CPU time of a steady frame, the primitives that
+// frame emits and the bytes allocated by each phase.
+//
+// With --check-allocations it exits with an error if a steady frame, or a
+// config reload once the buffers are warm, touches the heap at all, so a
+// regression of the zero-allocation frame or regeneration can be caught by
+// running it.
+
+#include "../BorderppCore.hpp"
+#include "../BorderppVines.hpp"
+#include "RecordingRenderer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+static size_t g_allocatedBytes = 0;
+static size_t g_allocations    = 0;
+
+void*         operator new(size_t size) {
+    g_allocatedBytes += size;
+    g_allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+struct SScenario {
+    size_t windows   = 1;
+    double w         = 0;
+    double h         = 0;
+    int    thickness = 2;
+    size_t borders   = 1;
+};
+
+struct SResult {
+    double generateUs = 0, relayoutUs = 0, frameUs = 0;
+    size_t generateBytes = 0, relayoutBytes = 0, frameBytes = 0, reloadBytes = 0;
+    size_t frameAllocations = 0;
+    size_t drawCalls = 0, stemVertices = 0, leaves = 0;
+};
+
+using CClock = std::chrono::steady_clock;
+
+static double usSince(CClock::time_point start) {
+    return std::chrono::duration<double, std::micro>(CClock::now() - start).count();
+}
+
+static SResult run(const SScenario& sc, size_t frames) {
+    constexpr double SCALE  = 1.0;
+    constexpr float  GROWTH = 1.F; // fully grown is the worst case
+
+    std::array<int, MAX_BORDERS>            sizes;
+    std::array<SBorderPPColor, MAX_BORDERS> colors;
+    sizes.fill(4);
+    colors.fill({0.2F, 0.5F, 0.9F, 0.9F});
+
+    const SBorderRingLayout LAYOUT = {.borders = sc.borders, .sizes = sizes, .colors = colors, .scale = SCALE, .rounding = 10, .naturalRounding = true};
+    const SBorderPPColor    VINECOLOR = vineColorFor(colors[0], false);
+    const double            THICKNESS = sc.borders * 4.0;
+
+    std::vector<CBorderPPVines> vines(sc.windows);
+    std::vector<SBorderPPRect>  boxes(sc.windows);
+    for (size_t i = 0; i < sc.windows; ++i) {
+        boxes[i] = {THICKNESS + i * 3.0, THICKNESS + i * 2.0, sc.w, sc.h};
+    }
+
+    CRecordingRenderer renderer;
+    SResult            result;
+
+    // first layout, with whatever allocations the buffers need
+    size_t bytes = g_allocatedBytes;
+    auto   start = CClock::now();
+    for (size_t i = 0; i < sc.windows; ++i) {
+        vines[i].update(boxes[i], SCALE, GROWTH, sc.thickness, 1);
+    }
+    result.generateUs    = usSince(start);
+    result.generateBytes = g_allocatedBytes - bytes;
+
+    // a config reload lays everything out again into the same buffers
+    bytes = g_allocatedBytes;
+    start = CClock::now();
+    for (size_t i = 0; i < sc.windows; ++i) {
+        vines[i].update(boxes[i], SCALE, GROWTH, sc.thickness, 2);
+    }
+    result.relayoutUs    = usSince(start);
+    result.relayoutBytes = g_allocatedBytes - bytes;
+
+    // one warm-up frame tessellates the stems
+    auto frame = [&] {
+        for (size_t i = 0; i < sc.windows; ++i) {
+            std::array<SBorderRing, MAX_BORDERS> rings;
+            const size_t                         COUNT = layoutBorderRings(LAYOUT, boxes[i], rings);
+            renderer.drawRings(boxes[i], {rings.data(), COUNT}, 2.F, 1.F);
+
+            vines[i].update(boxes[i], SCALE, GROWTH, sc.thickness, 2);
+            vines[i].draw(renderer, VINECOLOR, 1.F, sc.thickness);
+        }
+    };
+
+    frame();
+
+    renderer.reset();
+    bytes              = g_allocatedBytes;
+    size_t allocations = g_allocations;
+    start              = CClock::now();
+    for (size_t f = 0; f < frames; ++f) {
+        frame();
+    }
+    result.frameUs          = usSince(start) / frames;
+    result.frameBytes       = (g_allocatedBytes - bytes) / frames;
+    result.frameAllocations = g_allocations - allocations;
+
+    result.drawCalls    = renderer.drawCalls / frames;
+    result.stemVertices = renderer.stemVertices / frames;
+    result.leaves       = renderer.leaves / frames;
+
+    // with every buffer warm, another reload and the frame after it reuse them all
+    bytes = g_allocatedBytes;
+    for (size_t i = 0; i < sc.windows; ++i) {
+        vines[i].update(boxes[i], SCALE, GROWTH, sc.thickness, 3);
+    }
+    for (size_t i = 0; i < sc.windows; ++i) {
+        vines[i].update(boxes[i], SCALE, GROWTH, sc.thickness, 3);
+        vines[i].draw(renderer, VINECOLOR, 1.F, sc.thickness);
+    }
+    result.reloadBytes = g_allocatedBytes - bytes;
+
+    return result;
+}
+
+int main(int argc, char** argv) {
+    size_t frames            = 200;
+    bool   checkAllocations = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--frames") && i + 1 < argc)
+            frames = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--check-allocations"))
+            checkAllocations = true;
+        else {
+            std::fprintf(stderr, "usage: %s [--frames N] [--check-allocations]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const size_t WINDOWS[]   = {1, 8, 32};
+    const double SIZES[][2]  = {{640, 480}, {1280, 720}, {2560, 1440}};
+    const int    THICKNESS[] = {1, 2, 4};
+    const size_t BORDERS[]   = {1, 3, 9};
+
+    std::printf("%7s %9s %5s %7s | %9s %9s %9s | %6s %7s %6s | %9s %9s %7s %8s\n", "windows", "size", "thick", "borders", "gen us", "relay us", "frame us", "draws",
+                "verts", "leaves", "gen B", "relay B", "frame B", "reload B");
+
+    size_t failures = 0;
+
+    for (const auto WINDOWCOUNT : WINDOWS) {
+        for (const auto& SIZE : SIZES) {
+            for (const auto THICK : THICKNESS) {
+                for (const auto BORDERCOUNT : BORDERS) {
+                    const SScenario SC = {.windows = WINDOWCOUNT, .w = SIZE[0], .h = SIZE[1], .thickness = THICK, .borders = BORDERCOUNT};
+                    const auto      R  = run(SC, frames);
+
+                    std::printf("%7zu %4.0fx%-4.0f %5d %7zu | %9.1f %9.1f %9.1f | %6zu %7zu %6zu | %9zu %9zu %7zu %8zu\n", SC.windows, SC.w, SC.h, SC.thickness,
+                                SC.borders, R.generateUs, R.relayoutUs, R.frameUs, R.drawCalls, R.stemVertices, R.leaves, R.generateBytes, R.relayoutBytes, R.frameBytes,
+                                R.reloadBytes);
+
+                    if (R.frameAllocations > 0 || R.reloadBytes > 0)
+                        failures++;
+                }
+            }
+        }
+    }
+
+    if (checkAllocations && failures > 0) {
+        std::fprintf(stderr, "%zu scenarios allocated during steady frames or warm reloads\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,426 @@
+// Replays a recorded session against the headless core, with decorations that
+// follow the same damage and redraw rules as CBordersPlusPlus, and reports the
+// CPU time of every rendered frame, the draw calls it issued and its damaged area.
+//
+// Trace format, one event per line, '#' starts a comment. Positions and sizes
+// are logical, like Hyprland's window geometry; the monitor sits at 0, 0.
+//
+//   <ms> monitor <width> <height> <scale>
+//   <ms> config <add_borders> <border_size> <vine_thickness> [vine_primitive_budget]
+//   <ms> clock <HH:MM[:SS]>
+//   <ms> open <id> <workspace> <x> <y> <w> <h>
+//   <ms> close <id>
+//   <ms> move <id> <x> <y>
+//   <ms> resize <id> <w> <h>
+//   <ms> workspace <workspace> <render offset x> <render offset y>
+//   <ms> frame
+//
+// Timestamps are only used for the session length. A frame with no damage is
+// skipped, like Hyprland does.
+//
+// borders-plus-plus-replay --synthetic [windows] [hours] prints a synthetic
+// session with workspace switches, moves and resizes to replay.
+
+#include "../BorderppCore.hpp"
+#include "../BorderppVines.hpp"
+#include "RecordingRenderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SWindow {
+    int            id        = 0;
+    int            workspace = 0;
+    SBorderPPRect  geometry;
+    CBorderPPVines vines;
+    bool           drawn  = false;
+    float          sunset = 0.F;
+};
+
+struct SOffset {
+    double x = 0, y = 0;
+};
+
+struct SFrameStats {
+    double us        = 0;
+    size_t drawCalls = 0;
+    double area      = 0;
+};
+
+class CSession {
+  public:
+    CSession() {
+        m_sizes.fill(m_borderSize);
+        m_colors.fill({0.2F, 0.5F, 0.9F, 0.9F});
+        // only what the events damaged is redrawn, like on a real monitor
+        m_renderer.fullDamage = false;
+    }
+
+    bool apply(const std::string& line);
+
+    std::vector<SFrameStats> frames;
+    size_t                   skippedFrames = 0;
+    double                   lastMs        = 0;
+
+  private:
+    SWindow*      window(int id);
+    SBorderPPRect drawBounds(const SWindow& w) const;
+    void          damage(const SBorderPPRect& box);
+    void          damageWindow(const SWindow& w);
+    void          damageMonitor();
+    void          setClock(double seconds);
+    void          frame();
+
+    double        m_monitorW = 1920, m_monitorH = 1080, m_scale = 1.0;
+    size_t        m_borders = 1;
+    int           m_borderSize = 4, m_vineThickness = 2;
+    size_t        m_vineBudget       = VINE_DEFAULT_PRIMITIVE_BUDGET;
+    uint64_t      m_configGeneration = 1;
+    SVineGrowth   m_growth = vineGrowthAt(12 * 3600);
+
+    std::array<int, MAX_BORDERS>            m_sizes;
+    std::array<SBorderPPColor, MAX_BORDERS> m_colors;
+
+    std::vector<SWindow>                    m_windows;
+    std::unordered_map<int, SOffset>        m_offsets;
+    CRecordingRenderer                      m_renderer;
+};
+
+SWindow* CSession::window(int id) {
+    for (auto& w : m_windows) {
+        if (w.id == id)
+            return &w;
+    }
+    return nullptr;
+}
+
+// Everything the decoration can touch, in monitor pixels, see CBordersPlusPlus::getDrawBounds
+SBorderPPRect CSession::drawBounds(const SWindow& w) const {
+    const auto    OFFSET = m_offsets.contains(w.workspace) ? m_offsets.at(w.workspace) : SOffset{};
+    SBorderPPRect box    = w.geometry.expanded(m_borders * m_borderSize + m_vineThickness * VINE_LEAF_MARGIN);
+    return {(box.x + OFFSET.x) * m_scale, (box.y + OFFSET.y) * m_scale, box.w * m_scale, box.h * m_scale};
+}
+
+void CSession::damage(const SBorderPPRect& box) {
+    // clip to the monitor, anything outside is never rendered
+    const double X1 = std::max(box.x, 0.0), Y1 = std::max(box.y, 0.0);
+    const double X2 = std::min(box.x + box.w, m_monitorW * m_scale), Y2 = std::min(box.y + box.h, m_monitorH * m_scale);
+    if (X2 > X1 && Y2 > Y1)
+        m_renderer.damage.push_back({X1, Y1, X2 - X1, Y2 - Y1});
+}
+
+void CSession::damageWindow(const SWindow& w) {
+    damage(drawBounds(w));
+}
+
+void CSession::damageMonitor() {
+    damage({0, 0, m_monitorW * m_scale, m_monitorH * m_scale});
+}
+
+// Same rules as CBordersPlusPlus::onGrowthTick
+void CSession::setClock(double seconds) {
+    m_growth = vineGrowthAt(seconds);
+
+    for (auto& w : m_windows) {
+        if (w.vines.growth() == m_growth.growth && w.sunset == m_growth.sunset)
+            continue;
+
+        if (!w.drawn || !w.vines.ready() || w.sunset != m_growth.sunset || m_growth.growth < w.vines.growth()) {
+            damageWindow(w);
+            continue;
+        }
+
+        if (const auto GROWN = w.vines.grow(m_growth.growth))
+            damage(GROWN->expanded(m_vineThickness * VINE_LEAF_MARGIN));
+    }
+}
+
+// Area covered by the union of the damage rects
+static double unionArea(const std::vector<SBorderPPRect>& rects) {
+    std::vector<double> xs;
+    for (const auto& r : rects) {
+        xs.push_back(r.x);
+        xs.push_back(r.x + r.w);
+    }
+    std::ranges::sort(xs);
+
+    double                                 area = 0;
+    std::vector<std::pair<double, double>> spans;
+    for (size_t i = 0; i + 1 < xs.size(); ++i) {
+        const double X1 = xs[i], X2 = xs[i + 1];
+        if (X2 <= X1)
+            continue;
+
+        spans.clear();
+        for (const auto& r : rects) {
+            if (r.x <= X1 && r.x + r.w >= X2)
+                spans.emplace_back(r.y, r.y + r.h);
+        }
+        std::ranges::sort(spans);
+
+        if (spans.empty())
+            continue;
+
+        double covered = 0, top = spans[0].first, bottom = spans[0].second;
+        for (const auto& [y1, y2] : spans) {
+            if (y1 > bottom) {
+                covered += bottom - top;
+                top    = y1;
+                bottom = y2;
+            } else
+                bottom = std::max(bottom, y2);
+        }
+        covered += bottom - top;
+
+        area += covered * (X2 - X1);
+    }
+
+    return area;
+}
+
+// Renders every decoration touching the damage, see CBordersPlusPlus::drawPass
+void CSession::frame() {
+    if (m_renderer.damage.empty()) {
+        skippedFrames++;
+        return;
+    }
+
+    const SBorderPPColor    VINECOLOR = vineColorFor(m_colors[0], m_growth.sunset);
+    const double            ROUNDING  = (10 + m_borderSize) * m_scale;
+    const SBorderRingLayout LAYOUT    = {.borders = m_borders, .sizes = m_sizes, .colors = m_colors, .scale = m_scale, .rounding = ROUNDING, .naturalRounding = true};
+
+    m_renderer.reset();
+    m_renderer.view = {0, 0, m_monitorW * m_scale, m_monitorH * m_scale};
+
+    const auto START = std::chrono::steady_clock::now();
+
+    for (auto& w : m_windows) {
+        if (!m_renderer.isDamaged(drawBounds(w)))
+            continue;
+
+        const auto          OFFSET = m_offsets.contains(w.workspace) ? m_offsets.at(w.workspace) : SOffset{};
+        const SBorderPPRect INNER  = {std::round((w.geometry.x + OFFSET.x) * m_scale), std::round((w.geometry.y + OFFSET.y) * m_scale), std::round(w.geometry.w * m_scale),
+                                      std::round(w.geometry.h * m_scale)};
+
+        std::array<SBorderRing, MAX_BORDERS> rings;
+        const size_t                         COUNT = layoutBorderRings(LAYOUT, INNER, rings);
+        if (COUNT == 0)
+            continue;
+
+        if (m_renderer.isDamaged(INNER.expanded(rings[COUNT - 1].outer), INNER.expanded(-ROUNDING)))
+            m_renderer.drawRings(INNER, {rings.data(), COUNT}, 2.F, 1.F);
+
+        w.vines.update(INNER.expanded(rings[COUNT - 1].inner), m_scale, m_growth.growth, m_vineThickness, m_configGeneration, m_vineBudget);
+        w.vines.draw(m_renderer, VINECOLOR, 1.F, m_vineThickness);
+        w.drawn  = true;
+        w.sunset = m_growth.sunset;
+    }
+
+    const double US = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - START).count();
+
+    frames.push_back({US, m_renderer.drawCalls, unionArea(m_renderer.damage)});
+    m_renderer.damage.clear();
+}
+
+bool CSession::apply(const std::string& line) {
+    std::istringstream in(line.substr(0, line.find('#')));
+    double             ms = 0;
+    std::string        event;
+
+    if (!(in >> ms))
+        return in.eof(); // blank or comment
+
+    lastMs = ms;
+    in >> event;
+
+    if (event == "frame") {
+        frame();
+    } else if (event == "monitor") {
+        in >> m_monitorW >> m_monitorH >> m_scale;
+        damageMonitor();
+    } else if (event == "config") {
+        in >> m_borders >> m_borderSize >> m_vineThickness;
+        m_vineBudget = VINE_DEFAULT_PRIMITIVE_BUDGET;
+        if (!in.eof() && !(in >> std::ws).eof())
+            in >> m_vineBudget;
+        m_borders = std::min(m_borders, MAX_BORDERS);
+        m_sizes.fill(m_borderSize);
+        m_configGeneration++;
+        damageMonitor();
+    } else if (event == "clock") {
+        std::string time;
+        in >> time;
+        int h = 0, m = 0, s = 0;
+        if (std::sscanf(time.c_str(), "%d:%d:%d", &h, &m, &s) < 2)
+            return false;
+        setClock(h * 3600.0 + m * 60.0 + s);
+    } else if (event == "open") {
+        SWindow w;
+        in >> w.id >> w.workspace >> w.geometry.x >> w.geometry.y >> w.geometry.w >> w.geometry.h;
+        m_windows.emplace_back(std::move(w));
+        damageWindow(m_windows.back());
+    } else if (event == "close") {
+        int id = 0;
+        in >> id;
+        if (const auto* w = window(id))
+            damageWindow(*w);
+        std::erase_if(m_windows, [id](const SWindow& w) { return w.id == id; });
+    } else if (event == "move" || event == "resize") {
+        int    id = 0;
+        double a = 0, b = 0;
+        in >> id >> a >> b;
+        auto* w = window(id);
+        if (!w)
+            return true;
+        damageWindow(*w);
+        if (event == "move")
+            w->geometry.x = a, w->geometry.y = b;
+        else
+            w->geometry.w = a, w->geometry.h = b;
+        damageWindow(*w);
+    } else if (event == "workspace") {
+        int     ws = 0;
+        SOffset offset;
+        in >> ws >> offset.x >> offset.y;
+        for (const auto& w : m_windows) {
+            if (w.workspace == ws)
+                damageWindow(w);
+        }
+        m_offsets[ws] = offset;
+        for (const auto& w : m_windows) {
+            if (w.workspace == ws)
+                damageWindow(w);
+        }
+    } else
+        return false;
+
+    return !in.fail();
+}
+
+// A working day at 60fps: windows spread over four workspaces, a workspace
+// switch every couple of minutes and a window dragged or resized in between
+static void printSynthetic(int windows, double hours) {
+    constexpr int    WORKSPACES = 4;
+    constexpr double W = 2560, H = 1440, FRAMEMS = 1000.0 / 60.0;
+
+    std::mt19937     rng(1234);
+    auto             uniform = [&](double a, double b) { return std::uniform_real_distribution<double>(a, b)(rng); };
+
+    double           ms = 0;
+    std::printf("0 monitor %.0f %.0f 1.5\n0 config 2 4 2\n0 clock 08:00\n", W, H);
+
+    std::vector<std::array<double, 4>> geometry(windows);
+    for (int i = 0; i < windows; ++i) {
+        geometry[i] = {uniform(0, W - 800), uniform(0, H - 600), uniform(400, 1600), uniform(300, 900)};
+        std::printf("0 open %d %d %.0f %.0f %.0f %.0f\n", i, i % WORKSPACES, geometry[i][0], geometry[i][1], geometry[i][2], geometry[i][3]);
+    }
+    for (int ws = 1; ws < WORKSPACES; ++ws) {
+        std::printf("0 workspace %d %.0f 0\n", ws, ws * W);
+    }
+    std::printf("0 frame\n");
+
+    int active = 0;
+    for (int minute = 0; minute < hours * 60; ++minute) {
+        ms = minute * 60000.0;
+        std::printf("%.0f clock %02d:%02d\n%.0f frame\n", ms, (8 * 60 + minute) / 60 % 24, (8 * 60 + minute) % 60, ms);
+
+        // slide to another workspace over 20 frames
+        if (minute % 2 == 0) {
+            const int NEXT = (active + 1 + rng() % (WORKSPACES - 1)) % WORKSPACES;
+            for (int f = 1; f <= 20; ++f) {
+                ms += FRAMEMS;
+                const double T = f / 20.0;
+                std::printf("%.0f workspace %d %.0f 0\n%.0f workspace %d %.0f 0\n%.0f frame\n", ms, active, -T * W, ms, NEXT, (1 - T) * W, ms);
+            }
+            std::printf("%.0f workspace %d %.0f 0\n", ms, active, W * WORKSPACES);
+            active = NEXT;
+        }
+
+        // drag or resize one window on the active workspace over 30 frames
+        const int ID = (rng() % (windows / WORKSPACES + 1)) * WORKSPACES + active;
+        if (ID < windows) {
+            const bool   RESIZE = rng() % 2;
+            auto&        g      = geometry[ID];
+            const double DX = uniform(-200, 200), DY = uniform(-150, 150);
+            for (int f = 1; f <= 30; ++f) {
+                ms += FRAMEMS;
+                if (RESIZE) {
+                    g[2] = std::max(200.0, g[2] + DX / 30);
+                    g[3] = std::max(150.0, g[3] + DY / 30);
+                    std::printf("%.0f resize %d %.0f %.0f\n%.0f frame\n", ms, ID, g[2], g[3], ms);
+                } else {
+                    g[0] += DX / 30;
+                    g[1] += DY / 30;
+                    std::printf("%.0f move %d %.0f %.0f\n%.0f frame\n", ms, ID, g[0], g[1], ms);
+                }
+            }
+        }
+    }
+}
+
+static double percentile(std::vector<double>& sorted, double p) {
+    if (sorted.empty())
+        return 0;
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5))];
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && !std::strcmp(argv[1], "--synthetic")) {
+        printSynthetic(argc >= 3 ? std::max(1, std::atoi(argv[2])) : 40, argc >= 4 ? std::atof(argv[3]) : 8.0);
+        return 0;
+    }
+
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <trace | ->\n       %s --synthetic [windows] [hours]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    std::ifstream file;
+    if (std::strcmp(argv[1], "-"))
+        file.open(argv[1]);
+    std::istream& in = std::strcmp(argv[1], "-") ? file : std::cin;
+    if (!in) {
+        std::fprintf(stderr, "can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    CSession    session;
+    std::string line;
+    size_t      lineNo = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+        if (!session.apply(line)) {
+            std::fprintf(stderr, "line %zu: can't parse '%s'\n", lineNo, line.c_str());
+            return 1;
+        }
+    }
+
+    const auto&         FRAMES = session.frames;
+    std::vector<double> us;
+    size_t              drawCalls = 0;
+    double              area      = 0;
+    for (const auto& f : FRAMES) {
+        us.push_back(f.us);
+        drawCalls += f.drawCalls;
+        area += f.area;
+    }
+    std::ranges::sort(us);
+
+    const double N = std::max<size_t>(FRAMES.size(), 1);
+    std::printf("session      %.1f min, %zu frames rendered, %zu without damage\n", session.lastMs / 60000.0, FRAMES.size(), session.skippedFrames);
+    std::printf("frame us     p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n", percentile(us, 0.5), percentile(us, 0.9), percentile(us, 0.99), us.empty() ? 0 : us.back());
+    std::printf("draw calls   %.1f per frame, %zu total\n", drawCalls / N, drawCalls);
+    std::printf("damage       %.0f px per frame\n", area / N);
+
+    return 0;
+}
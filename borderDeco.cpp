@@ -6,39 +6,52 @@
 #include <hyprutils/memory/Casts.hpp>
 using namespace Hyprutils::Memory;
 #include "BorderppPassElement.hpp"
+#include "BorderppClock.hpp"
+#include "BorderppRenderer.hpp"
+#include "BorderppTrace.hpp"
 #include "globals.hpp"
+#include <hyprutils/utils/ScopeGuard.hpp>
+#include <chrono>
 #include <cmath>
-#include <random>
 #include <algorithm>
-#include <ctime>
-#include <chrono>
 
 // Constructor: Initializes the borders-plus-plus decoration for a window
 // Stores initial window position and size for tracking changes
+// The vines are seeded from the window class, so they look the same across restarts
 CBordersPlusPlus::CBordersPlusPlus(PHLWINDOW pWindow)
     : IHyprWindowDecoration(pWindow), m_pWindow(pWindow) {
   m_lastWindowPos = pWindow->m_realPosition->value();
   m_lastWindowSize = pWindow->m_realSize->value();
+  m_vines.setSeed(vineSeedFor(pWindow->m_initialClass));
+
+  g_pBorderPPClock->registerDecoration(this);
 }
 
 // Destructor: Cleans up the decoration and damages the entire area for redraw
-CBordersPlusPlus::~CBordersPlusPlus() { damageEntire(); }
+// Releasing the vine cache needs the GL context
+CBordersPlusPlus::~CBordersPlusPlus() {
+  // Decorations are removed after PLUGIN_EXIT
+  if (g_pBorderPPClock)
+    g_pBorderPPClock->unregisterDecoration(this);
+
+  for (auto &cache : m_vineCaches) {
+    if (!cache.fb.isAllocated())
+      continue;
+
+    g_pHyprRenderer->makeEGLCurrent();
+    cache.fb.release();
+    cache.stencil.reset();
+  }
+
+  damageEntire();
+}
 
 // Returns positioning information for the decoration
 // Calculates the total border thickness and reserves space around the window
 SDecorationPositioningInfo CBordersPlusPlus::getPositioningInfo() {
-  static auto *const PBORDERS =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:borders-plus-plus:add_borders")
-          ->getDataStaticPtr();
-
-  static std::vector<Hyprlang::INT *const *> PSIZES;
-  for (size_t i = 0; i < 9; ++i) {
-    PSIZES.push_back((Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-                         PHANDLE, "plugin:borders-plus-plus:border_size_" +
-                                      std::to_string(i + 1))
-                         ->getDataStaticPtr());
-  }
+  BPP_TRACE_ZONE("getPositioningInfo");
+
+  const auto &CFG = g_pBorderPPConfig->get();
 
   SDecorationPositioningInfo info;
   info.policy = DECORATION_POSITION_STICKY;
@@ -48,11 +61,7 @@ SDecorationPositioningInfo CBordersPlusPlus::getPositioningInfo() {
                DECORATION_EDGE_RIGHT | DECORATION_EDGE_TOP;
 
   if (m_fLastThickness == 0) {
-    double size = 0;
-
-    for (size_t i = 0; i < **PBORDERS; ++i) {
-      size += **PSIZES[i];
-    }
+    const double size = CFG.totalThickness;
 
     info.desiredExtents = {{size, size}, {size, size}};
     m_fLastThickness = size;
@@ -95,477 +104,326 @@ void CBordersPlusPlus::draw(PHLMONITOR pMonitor, const float &a) {
   if (!PWINDOW->m_windowData.decorate.valueOrDefault())
     return;
 
+  const auto TIER = pickTier(PWINDOW);
+  if (TIER != m_eTier) {
+    m_eTier = TIER;
+    damageEntire();
+  }
+
+  if (m_eTier == BPP_TIER_NONE)
+    return;
+
   CBorderPPPassElement::SBorderPPData data;
   data.deco = this;
 
+  // The render pass takes ownership and frees the element after the frame, so this
+  // is the one allocation a steady frame still makes; the API has no way to reuse it
   g_pHyprRenderer->m_renderPass.add(makeUnique<CBorderPPPassElement>(data));
 }
 
-// Calculates vine growth progress based on current time of day
-// Returns 0.0 at midnight, 1.0 at 17:00 (5 PM)
-float CBordersPlusPlus::getVineGrowthProgress() {
-  auto now = std::chrono::system_clock::now();
-  auto time = std::chrono::system_clock::to_time_t(now);
-  auto localTime = std::localtime(&time);
-  
-  // Get current hour and minute
-  float currentHour = localTime->tm_hour + (localTime->tm_min / 60.0f);
-  
-  // Growth from 0:00 to 17:00 (17 hours)
-  const float TARGET_HOUR = 17.0f;
-  
-  if (currentHour >= TARGET_HOUR) {
-    return 1.0f; // Full growth after 5 PM
+// Picks the quality tier for this frame from what the user can actually see
+// Hidden behind a fullscreen window: nothing; focused or being resized: full vines;
+// with cache_vines, unfocused or moving with a workspace slide or window animation:
+// the cached vine layer
+eBorderPPTier CBordersPlusPlus::pickTier(PHLWINDOW pWindow) {
+  const auto PWORKSPACE = pWindow->m_workspace;
+
+  if (PWORKSPACE && PWORKSPACE->m_hasFullscreenWindow && PWORKSPACE->m_fullscreenMode == FSMODE_FULLSCREEN && !pWindow->isFullscreen() &&
+      !pWindow->m_createdOverFullscreen && !PWORKSPACE->m_renderOffset->isBeingAnimated())
+    return BPP_TIER_NONE;
+
+  // window rules pin the tier with a tag
+  if (!pWindow->m_tags.getTags().empty()) {
+    if (pWindow->m_tags.isTagged("bpp-none"))
+      return BPP_TIER_NONE;
+    if (pWindow->m_tags.isTagged("bpp-borders"))
+      return BPP_TIER_BORDERS;
+    if (pWindow->m_tags.isTagged("bpp-cached"))
+      return BPP_TIER_CACHED;
+    if (pWindow->m_tags.isTagged("bpp-full"))
+      return BPP_TIER_FULL;
   }
-  
-  // Linear growth from 0 to 1 over 17 hours
-  return currentHour / TARGET_HOUR;
+
+  // A resize would make the cache stale every frame, drawing directly is cheaper
+  if (pWindow->m_realSize->isBeingAnimated())
+    return BPP_TIER_FULL;
+
+  // Every cached window holds a window-sized texture, so that is only done when cache_vines asks for it
+  if (!g_pBorderPPConfig->get().cacheVines)
+    return BPP_TIER_FULL;
+
+  const bool SLIDING = (PWORKSPACE && PWORKSPACE->m_renderOffset->isBeingAnimated()) || pWindow->m_realPosition->isBeingAnimated();
+
+  if (SLIDING || g_pCompositor->m_lastWindow.lock() != pWindow)
+    return BPP_TIER_CACHED;
+
+  return BPP_TIER_FULL;
+}
+
+// Returns vine growth progress for the current time of day, in 1% steps
+// 0.0 at midnight, 1.0 at 17:00 (5 PM) by default; sampled by the plugin clock, not per frame
+float CBordersPlusPlus::getVineGrowthProgress() {
+  return g_pBorderPPClock->growth();
 }
 
-// Returns vine color based on time of day
-// Green during growth hours (0:00-17:00), orange after 17:00
-CHyprColor CBordersPlusPlus::getVineColorForTime(const CHyprColor& baseColor) {
-  auto now = std::chrono::system_clock::now();
-  auto time = std::chrono::system_clock::to_time_t(now);
-  auto localTime = std::localtime(&time);
-  
-  float currentHour = localTime->tm_hour + (localTime->tm_min / 60.0f);
-  const float SUNSET_HOUR = 17.0f;
-  
-  CHyprColor vineColor = baseColor;
-  
-  if (currentHour >= SUNSET_HOUR) {
-    // Orange sunset color after 17:00
-    vineColor.r = std::min(vineColor.r * 1.5 + 0.3, 1.0);
-    vineColor.g = std::min(vineColor.g * 0.8 + 0.2, 1.0);
-    vineColor.b = std::min(vineColor.b * 0.3, 1.0);
-  } else {
-    // Green color during day
-    vineColor.r = std::min(vineColor.r * 0.5 + 0.2, 1.0);
-    vineColor.g = std::min(vineColor.g * 1.2, 1.0);
-    vineColor.b = std::min(vineColor.b * 0.5, 1.0);
+// Called by the plugin clock when a growth step or the sunset color is due
+// Damages the decoration only if its vines look different now
+void CBordersPlusPlus::onGrowthTick() {
+  if (!validMapped(m_pWindow) || !g_pBorderPPConfig->get().vines)
+    return;
+
+  // Vines that aren't drawn catch up when the tier goes back up
+  if (m_eTier >= BPP_TIER_BORDERS)
+    return;
+
+  m_counters.add(&SBorderPPCounters::growthWakeups, 1);
+
+  const float growthProgress = g_pBorderPPClock->growth();
+  if (m_vines.growth() == growthProgress && m_fLastSunset == g_pBorderPPClock->sunset())
+    return;
+
+  // Color changes and the midnight reset affect everything
+  const auto PMONITOR = m_pVineMonitor.lock();
+  if (!PMONITOR || !m_vines.ready() || m_fLastSunset != g_pBorderPPClock->sunset() ||
+      growthProgress < m_vines.growth()) {
+    damageEntire();
+    return;
   }
-  
-  return vineColor;
+
+  // Growth only extends the tips, so only the new segments need a repaint
+  const auto grown = m_vines.grow(growthProgress);
+  if (!grown)
+    return;
+
+  const double leafMargin = g_pBorderPPConfig->get().vineThickness * VINE_LEAF_MARGIN;
+  CBox damage = {grown->x, grown->y, grown->w, grown->h};
+  damage.translate(m_vVineOrigin).expand(leafMargin).scale(1.0 / PMONITOR->m_scale).translate(PMONITOR->m_position);
+  g_pHyprRenderer->damageBox(damage);
 }
 
-// Generates a curved vine path between two points
-// Creates natural-looking curves using sine waves and randomization
-void CBordersPlusPlus::generateVinePath(std::vector<Vector2D>& points, Vector2D start, Vector2D end, int segments, float curviness) {
-  points.clear();
-  
-  static std::mt19937 rng(std::random_device{}());
-  std::uniform_real_distribution<float> dist(-curviness, curviness);
-  
-  Vector2D direction = end - start;
-  float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-  Vector2D normalized = {direction.x / length, direction.y / length};
-  Vector2D perpendicular = {-normalized.y, normalized.x};
-  
-  for (int i = 0; i <= segments; ++i) {
-    float t = static_cast<float>(i) / segments;
-    
-    // Base position along the line
-    Vector2D basePos = start + direction * t;
-    
-    // Add sinusoidal wave for organic look
-    float wave = std::sin(t * M_PI * 3.0f + m_fVineAnimationTime * 0.5f) * curviness * 2.0f;
-    
-    // Add some randomness for natural variation
-    float randomOffset = dist(rng) * 0.3f;
-    
-    // Apply perpendicular offset
-    Vector2D offset = perpendicular * (wave + randomOffset);
-    
-    points.push_back(basePos + offset);
+// Called by the plugin clock for every animation frame of vine_animate
+// Damages only the swaying strips, and only on the monitor they were drawn on
+void CBordersPlusPlus::onAnimationTick(std::span<const MONITORID> dueMonitors) {
+  // cached vines are a still image, and hidden ones catch up when they come back
+  if (m_eTier != BPP_TIER_FULL)
+    return;
+
+  const auto PMONITOR = m_pVineMonitor.lock();
+  if (!PMONITOR || std::ranges::find(dueMonitors, PMONITOR->m_id) == dueMonitors.end())
+    return;
+
+  for (const auto& r : m_vines.animatedBounds(g_pBorderPPConfig->get().vineThickness)) {
+    CBox damage = {r.x, r.y, r.w, r.h};
+    damage.translate(m_vVineOrigin).scale(1.0 / PMONITOR->m_scale).translate(PMONITOR->m_position);
+    g_pHyprRenderer->damageBox(damage);
+
+    m_counters.add(&SBorderPPCounters::animationDamageArea, damage.width * damage.height);
   }
 }
 
+// Called by the plugin when a background vine layout is done
+// Damages the decoration so the next draw swaps the new layout in
+void CBordersPlusPlus::onVinesBuilt() {
+  if (m_vines.layoutReady())
+    damageEntire();
+}
+
 // Draws decorative vines around the window
-// Creates multiple vine strands with leaves and tendrils
-// Vines grow from top-left based on time of day
-void CBordersPlusPlus::drawVines(PHLMONITOR pMonitor, const CBox& box, const float& a, const CHyprColor& color, int thickness) {
-  const int numVines = 3; // Number of vine strands per side
-  const int segments = 40; // Smoothness of the vine curves (increased for smoother appearance)
-  const float curviness = thickness * 0.5f;
-  
-  // Get current growth progress
-  float growthProgress = getVineGrowthProgress();
-  
-  // Check for growth changes periodically and request redraw
-  static auto s_lastCheckTime = std::chrono::system_clock::now();
-  auto currentTime = std::chrono::system_clock::now();
-  auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(currentTime - s_lastCheckTime).count();
-  
-  // Check every 30 seconds for growth changes
-  if (elapsed >= 30) {
-    if (std::abs(growthProgress - m_fLastGrowthProgress) > 0.005f) {
-      // Growth has changed - request a redraw
-      m_bVinePathsGenerated = false;
-      damageEntire();
+// Vines grow from top-left based on time of day; laying them out, growing and
+// tessellating them is done by the compositor-independent CBorderPPVines
+// When animated they sway on the GPU from the monotonic clock, the geometry stays put
+// origin is where box's coordinates start in monitor-local pixels; it is kept with the
+// monitor so growth damage lands where these paths end up on screen
+void CBordersPlusPlus::drawVines(PHLMONITOR pMonitor, const CBox& box, const Vector2D& origin, const float& a, const SBorderPPColor& color, int thickness,
+                                 bool animate) {
+  BPP_TRACE_ZONE("drawVines");
+
+  m_pVineMonitor = pMonitor;
+  m_vVineOrigin = origin;
+
+  const uint64_t regenerations = m_vines.regenerations();
+  m_vines.update({box.x, box.y, box.width, box.height}, pMonitor->m_scale, getVineGrowthProgress(), thickness,
+                 g_pBorderPPConfig->get().generation, g_pBorderPPConfig->get().vineBudget, (uint64_t)pMonitor->m_id);
+  m_counters.add(&SBorderPPCounters::regenerations, m_vines.regenerations() - regenerations);
+  const float time = animate ? vineAnimationTime(std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count()) : 0.F;
+  m_vines.draw(*g_pBorderPPRenderer, color, a, thickness, time, animate);
+}
+
+// Returns the offscreen vine layer for pMonitor at its scale
+// A monitor whose scale changed takes over its old layer, others recycle an unused or
+// the least recently used one; a taken over or recycled layer has to be re-rendered
+CBordersPlusPlus::SVineCache& CBordersPlusPlus::vineCacheFor(PHLMONITOR pMonitor) {
+  SVineCache* pick = &m_vineCaches[0];
+  for (auto &cache : m_vineCaches) {
+    if (cache.monitor == pMonitor->m_id) {
+      pick = &cache;
+      break;
     }
-    s_lastCheckTime = currentTime;
+
+    if (cache.lastUse < pick->lastUse)
+      pick = &cache;
   }
-  
-  // Regenerate vines if growth progress changed significantly (every ~1% or 10 minutes)
-  if (!m_bVinePathsGenerated || m_vVinePaths.empty() || 
-      std::abs(growthProgress - m_fLastGrowthProgress) > 0.01f) {
-    m_vVinePaths.clear();
-    m_fLastGrowthProgress = growthProgress;
-    
-    // Calculate which edges to populate based on growth
-    // Growth pattern: top-left corner expands clockwise
-    // 0% = just top-left corner
-    // 25% = top edge complete
-    // 50% = top + right edge
-    // 75% = top + right + bottom
-    // 100% = all edges
-    
-    bool drawTop = growthProgress > 0.0f;
-    bool drawRight = growthProgress > 0.25f;
-    bool drawBottom = growthProgress > 0.5f;
-    bool drawLeft = growthProgress > 0.75f;
-    
-    // Top vines - scale from left to right
-    if (drawTop) {
-      float topProgress = std::min((growthProgress * 4.0f), 1.0f);
-      for (int i = 0; i < numVines; ++i) {
-        std::vector<Vector2D> vinePath;
-        float vineEnd = box.width * topProgress * (i + 1) / numVines;
-        Vector2D start = {box.x + (box.width * i) / numVines, box.y};
-        Vector2D end = {box.x + vineEnd, box.y};
-        if (vineEnd > start.x) {
-          generateVinePath(vinePath, start, end, segments, curviness);
-          m_vVinePaths.push_back(vinePath);
-        }
-      }
-    }
-    
-    // Right vines - scale from top to bottom
-    if (drawRight) {
-      float rightProgress = std::min((growthProgress - 0.25f) * 4.0f, 1.0f);
-      for (int i = 0; i < numVines; ++i) {
-        std::vector<Vector2D> vinePath;
-        float vineEnd = box.height * rightProgress * (i + 1) / numVines;
-        Vector2D start = {box.x + box.width, box.y + (box.height * i) / numVines};
-        Vector2D end = {box.x + box.width, box.y + vineEnd};
-        if (vineEnd > start.y - box.y) {
-          generateVinePath(vinePath, start, end, segments, curviness);
-          m_vVinePaths.push_back(vinePath);
-        }
-      }
-    }
-    
-    // Bottom vines - scale from right to left
-    if (drawBottom) {
-      float bottomProgress = std::min((growthProgress - 0.5f) * 4.0f, 1.0f);
-      for (int i = 0; i < numVines; ++i) {
-        std::vector<Vector2D> vinePath;
-        float vineStart = box.width * (1.0f - bottomProgress * (i + 1) / numVines);
-        Vector2D start = {box.x + box.width - (box.width * i) / numVines, box.y + box.height};
-        Vector2D end = {box.x + vineStart, box.y + box.height};
-        if (start.x > end.x) {
-          generateVinePath(vinePath, start, end, segments, curviness);
-          m_vVinePaths.push_back(vinePath);
-        }
-      }
-    }
-    
-    // Left vines - scale from bottom to top
-    if (drawLeft) {
-      float leftProgress = std::min((growthProgress - 0.75f) * 4.0f, 1.0f);
-      for (int i = 0; i < numVines; ++i) {
-        std::vector<Vector2D> vinePath;
-        float vineStart = box.height * (1.0f - leftProgress * (i + 1) / numVines);
-        Vector2D start = {box.x, box.y + box.height - (box.height * i) / numVines};
-        Vector2D end = {box.x, box.y + vineStart};
-        if (start.y > end.y) {
-          generateVinePath(vinePath, start, end, segments, curviness);
-          m_vVinePaths.push_back(vinePath);
-        }
-      }
-    }
-    
-    m_bVinePathsGenerated = true;
+
+  if (pick->monitor != pMonitor->m_id || pick->scale != pMonitor->m_scale) {
+    pick->monitor = pMonitor->m_id;
+    pick->scale = pMonitor->m_scale;
+    pick->growth = -1.0f;
   }
-  
-  // Update animation time
-  m_fVineAnimationTime += 0.016f; // Assuming ~60fps
-  
-  // Helper lambda to draw a stylized leaf using multiple circles
-  // Creates a more distinct leaf shape rather than a single rounded rectangle
-  auto drawLeaf = [&](Vector2D pos, float size, const CHyprColor& leafColor, float angleOffset) {
-    // Draw leaf as overlapping circles to create an organic, non-circular shape
-    // This creates a more recognizable leaf silhouette
-    
-    // Left lobe of leaf
-    CBox leftLobe = {
-      pos.x - size * 0.55f,
-      pos.y - size * 0.35f,
-      static_cast<double>(size * 0.6f),
-      static_cast<double>(size * 0.7f)
-    };
-    g_pHyprOpenGL->renderRect(leftLobe, leafColor, {.round = sc<int>(size * 0.3f)});
-    
-    // Right lobe of leaf
-    CBox rightLobe = {
-      pos.x - size * 0.05f,
-      pos.y - size * 0.35f,
-      static_cast<double>(size * 0.6f),
-      static_cast<double>(size * 0.7f)
-    };
-    g_pHyprOpenGL->renderRect(rightLobe, leafColor, {.round = sc<int>(size * 0.3f)});
-    
-    // Center body connecting the lobes
-    CBox center = {
-      pos.x - size * 0.35f,
-      pos.y - size * 0.25f,
-      static_cast<double>(size * 0.7f),
-      static_cast<double>(size * 0.6f)
-    };
-    g_pHyprOpenGL->renderRect(center, leafColor, {.round = sc<int>(size * 0.2f)});
-    
-    // Pointed tip at bottom
-    CBox tip = {
-      pos.x - size * 0.2f,
-      pos.y + size * 0.15f,
-      static_cast<double>(size * 0.4f),
-      static_cast<double>(size * 0.5f)
-    };
-    g_pHyprOpenGL->renderRect(tip, leafColor, {.round = sc<int>(size * 0.15f)});
-    
-    // Small stem at base
-    CBox stem = {
-      pos.x - size * 0.08f,
-      pos.y + size * 0.5f,
-      static_cast<double>(size * 0.16f),
-      static_cast<double>(size * 0.25f)
-    };
-    CHyprColor stemColor = leafColor;
-    stemColor.r *= 0.7f;
-    stemColor.g *= 0.8f;
-    stemColor.b *= 0.7f;
-    g_pHyprOpenGL->renderRect(stem, stemColor, {.round = sc<int>(size * 0.08f)});
-  };
-  
-  // Draw the vines
-  for (const auto& vinePath : m_vVinePaths) {
-    if (vinePath.size() < 2) continue;
-    
-    // Draw the main vine stem using small overlapping circles for smooth lines
-    for (size_t i = 0; i < vinePath.size(); ++i) {
-      Vector2D p = vinePath[i];
-      
-      // Draw smooth stem using circles (not leaves for the main line)
-      float stemSize = static_cast<float>(thickness) * 0.8f;
-      CBox stemCircle = {
-        p.x - stemSize / 2.0f,
-        p.y - stemSize / 2.0f,
-        static_cast<double>(stemSize),
-        static_cast<double>(stemSize)
-      };
-      
-      CHyprColor stemColor = color;
-      stemColor.a = a;
-      // Darken stem slightly
-      stemColor.r *= 0.8f;
-      stemColor.g *= 0.9f;
-      stemColor.b *= 0.8f;
-      
-      g_pHyprOpenGL->renderRect(stemCircle, stemColor, {.round = sc<int>(stemSize / 2)});
-      
-      // For thicker vines, draw additional connecting segments between points
-      if (i > 0) {
-        Vector2D p1 = vinePath[i - 1];
-        Vector2D p2 = vinePath[i];
-        
-        // Draw interpolated circles between points for smooth stems
-        float dx = p2.x - p1.x;
-        float dy = p2.y - p1.y;
-        float distance = std::sqrt(dx * dx + dy * dy);
-        int steps = std::max(1, static_cast<int>(distance / (thickness * 0.4f)));
-        
-        for (int step = 1; step < steps; ++step) {
-          float t = static_cast<float>(step) / steps;
-          Vector2D interpPoint = {
-            p1.x + dx * t,
-            p1.y + dy * t
-          };
-          
-          CBox interpCircle = {
-            interpPoint.x - stemSize / 2.0f,
-            interpPoint.y - stemSize / 2.0f,
-            static_cast<double>(stemSize),
-            static_cast<double>(stemSize)
-          };
-          
-          g_pHyprOpenGL->renderRect(interpCircle, stemColor, {.round = sc<int>(stemSize / 2)});
-        }
-      }
-    }
-    
-    // Draw larger decorative leaves at intervals
-    for (size_t i = 0; i < vinePath.size(); i += 10) {  // Less frequent, more impactful
-      float decorativeLeafSize = thickness * 4.0f;
-      
-      // Calculate direction for leaf orientation
-      Vector2D direction = {1, 0};
-      if (i > 0 && i < vinePath.size() - 1) {
-        direction.x = vinePath[i + 1].x - vinePath[i - 1].x;
-        direction.y = vinePath[i + 1].y - vinePath[i - 1].y;
-        float len = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-        if (len > 0.01f) {
-          direction.x /= len;
-          direction.y /= len;
-        }
+
+  pick->lastUse = ++m_iVineCacheClock;
+  return *pick;
+}
+
+// Draws the vines through a per-decoration, per-monitor offscreen texture
+// The vine layer is only re-rendered on resize, growth step, color change, new layout
+// or config reload; otherwise it costs a single textured quad
+void CBordersPlusPlus::drawVinesCached(PHLMONITOR pMonitor, const CBox& box, const float& a, const SBorderPPColor& color, int thickness) {
+  // Leaves stick out of the box, keep room for them around the cached layer
+  const double pad = std::ceil(thickness * VINE_LEAF_MARGIN);
+  const Vector2D cacheSize = {std::ceil(box.width + pad * 2), std::ceil(box.height + pad * 2)};
+  const float growthProgress = getVineGrowthProgress();
+  auto &cache = vineCacheFor(pMonitor);
+
+  const bool stale = !cache.fb.isAllocated() || cache.fb.m_size != cacheSize || m_vines.layoutReady() ||
+                     cache.regenerations != m_vines.regenerations() || growthProgress != cache.growth ||
+                     cache.color != color || cache.thickness != thickness ||
+                     cache.configGeneration != g_pBorderPPConfig->get().generation;
+
+  if (stale) {
+    if (cache.fb.m_size != cacheSize) {
+      cache.fb.release();
+      if (!cache.stencil) {
+        cache.stencil = makeShared<CTexture>();
+        cache.stencil->allocate();
+        cache.fb.addStencil(cache.stencil);
       }
-      
-      // Offset leaf perpendicular to vine direction (alternating sides)
-      float side = (i / 10) % 2 == 0 ? 1.0f : -1.0f;
-      float perpX = -direction.y * side * decorativeLeafSize * 0.5f;
-      float perpY = direction.x * side * decorativeLeafSize * 0.5f;
-      
-      Vector2D leafPos = {
-        vinePath[i].x + perpX,
-        vinePath[i].y + perpY
-      };
-      
-      // Make decorative leaves slightly transparent and vibrant
-      CHyprColor decorativeColor = color;
-      decorativeColor.a = a * 0.8f;
-      
-      // Add angle variation for natural look
-      float angleVariation = std::sin(i * 0.5f + m_fVineAnimationTime * 0.2f) * 0.3f;
-      
-      drawLeaf(leafPos, decorativeLeafSize, decorativeColor, angleVariation);
+      cache.fb.alloc(cacheSize.x, cacheSize.y);
     }
+
+    g_pBorderPPRenderer->beginOffscreen(cache.fb);
+    drawVines(pMonitor, CBox{pad, pad, box.width, box.height}, {box.x - pad, box.y - pad}, 1.0f, color, thickness, false);
+    g_pBorderPPRenderer->endOffscreen();
+
+    cache.growth = growthProgress;
+    cache.color = color;
+    cache.thickness = thickness;
+    cache.configGeneration = g_pBorderPPConfig->get().generation;
+    cache.regenerations = m_vines.regenerations();
   }
+
+  CBox texBox = {box.x - pad, box.y - pad, cacheSize.x, cacheSize.y};
+  g_pHyprOpenGL->renderTexture(cache.fb.getTexture(), texBox, {.a = a});
+  g_pBorderPPRenderer->m_issued.drawCalls++;
+  g_pBorderPPRenderer->m_issued.triangles += 2;
+}
+
+// Returns the assigned geometry in monitor-local logical coordinates
+// Follows the workspace render offset so it moves with workspace slides
+CBox CBordersPlusPlus::getMonitorLocalBox(PHLMONITOR pMonitor) {
+  const auto PWINDOW = m_pWindow.lock();
+
+  const auto PWORKSPACE = PWINDOW->m_workspace;
+  const auto WORKSPACEOFFSET = PWORKSPACE && !PWINDOW->m_pinned
+                                   ? PWORKSPACE->m_renderOffset->value()
+                                   : Vector2D();
+
+  CBox box = m_bAssignedGeometry;
+  box.translate(g_pDecorationPositioner->getEdgeDefinedPoint(
+      DECORATION_EDGE_BOTTOM | DECORATION_EDGE_LEFT | DECORATION_EDGE_RIGHT |
+          DECORATION_EDGE_TOP,
+      PWINDOW));
+
+  box.translate(PWINDOW->m_floatingOffset - pMonitor->m_position +
+                WORKSPACEOFFSET);
+
+  return box;
+}
+
+// Returns the area the decoration can draw into, in monitor-local logical coordinates
+// Leaves stick out past the borders, so vines widen it by their margin
+CBox CBordersPlusPlus::getDrawBounds(PHLMONITOR pMonitor) {
+  const auto &CFG = g_pBorderPPConfig->get();
+
+  CBox box = getMonitorLocalBox(pMonitor);
+  if (CFG.vines)
+    box.expand(CFG.vineThickness * VINE_LEAF_MARGIN);
+
+  return box;
 }
 
 // Performs the actual rendering of the borders
 // Draws multiple border layers based on configuration, handling colors, sizes, and rounding
-void CBordersPlusPlus::drawPass(PHLMONITOR pMonitor, const float &a) {
+// Only the part of damage that overlaps the decoration is redrawn
+void CBordersPlusPlus::drawPass(PHLMONITOR pMonitor, const float &a, const CRegion &damage) {
+  BPP_TRACE_ZONE("drawPass");
+
   const auto PWINDOW = m_pWindow.lock();
 
-  static std::vector<Hyprlang::INT *const *> PCOLORS;
-  static std::vector<Hyprlang::INT *const *> PSIZES;
-  for (size_t i = 0; i < 9; ++i) {
-    PCOLORS.push_back((Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-                          PHANDLE, "plugin:borders-plus-plus:col.border_" +
-                                       std::to_string(i + 1))
-                          ->getDataStaticPtr());
-    PSIZES.push_back((Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-                         PHANDLE, "plugin:borders-plus-plus:border_size_" +
-                                      std::to_string(i + 1))
-                         ->getDataStaticPtr());
-  }
-  static auto *const PBORDERS =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:borders-plus-plus:add_borders")
-          ->getDataStaticPtr();
-  static auto *const PNATURALROUND =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:borders-plus-plus:natural_rounding")
-          ->getDataStaticPtr();
-  static auto *const PROUNDING =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE,
-                                                          "decoration:rounding")
-          ->getDataStaticPtr();
-  static auto *const PBORDERSIZE =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE,
-                                                          "general:border_size")
-          ->getDataStaticPtr();
-  static auto *const PVINETOGGLE =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:borders-plus-plus:enable_vines")
-          ->getDataStaticPtr();
-  static auto *const PVINETHICKNESS =
-      (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(
-          PHANDLE, "plugin:borders-plus-plus:vine_thickness")
-          ->getDataStaticPtr();
-
-  if (**PBORDERS < 1)
+  const auto &CFG = g_pBorderPPConfig->get();
+
+  if (CFG.borders < 1)
     return;
 
   if (m_bAssignedGeometry.width < m_seExtents.topLeft.x + 1 ||
       m_bAssignedGeometry.height < m_seExtents.topLeft.y + 1)
     return;
 
-  const auto PWORKSPACE = PWINDOW->m_workspace;
-  const auto WORKSPACEOFFSET = PWORKSPACE && !PWINDOW->m_pinned
-                                   ? PWORKSPACE->m_renderOffset->value()
-                                   : Vector2D();
-
-  auto rounding =
+  const double rounding =
       PWINDOW->rounding() == 0
           ? 0
-          : (PWINDOW->rounding() + **PBORDERSIZE) * pMonitor->m_scale;
+          : (PWINDOW->rounding() + CFG.borderSize) * pMonitor->m_scale;
   const auto ROUNDINGPOWER = PWINDOW->roundingPower();
-  const auto ORIGINALROUND =
-      rounding == 0 ? 0
-                    : (PWINDOW->rounding() + **PBORDERSIZE) * pMonitor->m_scale;
 
-  CBox fullBox = m_bAssignedGeometry;
-  fullBox.translate(g_pDecorationPositioner->getEdgeDefinedPoint(
-      DECORATION_EDGE_BOTTOM | DECORATION_EDGE_LEFT | DECORATION_EDGE_RIGHT |
-          DECORATION_EDGE_TOP,
-      m_pWindow.lock()));
-
-  fullBox.translate(PWINDOW->m_floatingOffset - pMonitor->m_position +
-                    WORKSPACEOFFSET);
+  CBox fullBox = getMonitorLocalBox(pMonitor);
 
   if (fullBox.width < 1 || fullBox.height < 1)
     return;
 
-  double fullThickness = 0;
+  if (!g_pBorderPPRenderer)
+    g_pBorderPPRenderer = makeUnique<CBorderPPRenderer>();
 
-  for (size_t i = 0; i < **PBORDERS; ++i) {
-    const int THISBORDERSIZE =
-        **(PSIZES[i]) == -1 ? **PBORDERSIZE : (**PSIZES[i]);
-    fullThickness += THISBORDERSIZE;
-  }
-
-  fullBox.expand(-fullThickness).scale(pMonitor->m_scale).round();
-
-  for (size_t i = 0; i < **PBORDERS; ++i) {
-    const int PREVBORDERSIZESCALED =
-        i == 0 ? 0
-               : (**PSIZES[i - 1] == -1 ? **PBORDERSIZE : **(PSIZES[i - 1])) *
-                     pMonitor->m_scale;
-    const int THISBORDERSIZE =
-        **(PSIZES[i]) == -1 ? **PBORDERSIZE : (**PSIZES[i]);
-
-    if (i != 0) {
-      rounding += rounding == 0 ? 0 : PREVBORDERSIZESCALED;
-      fullBox.x -= PREVBORDERSIZESCALED;
-      fullBox.y -= PREVBORDERSIZESCALED;
-      fullBox.width += PREVBORDERSIZESCALED * 2;
-      fullBox.height += PREVBORDERSIZESCALED * 2;
-    }
+  // Narrow the damage to the decoration, everything below scissors to it
+  if (!g_pBorderPPRenderer->pushDamage(getDrawBounds(pMonitor).scale(pMonitor->m_scale).round(), damage))
+    return;
 
-    if (fullBox.width < 1 || fullBox.height < 1)
-      break;
+  Hyprutils::Utils::CScopeGuard restoreDamage([] { g_pBorderPPRenderer->popDamage(); });
 
-    g_pHyprOpenGL->scissor(nullptr);
+  const double fullThickness = CFG.totalThickness;
 
-    g_pHyprOpenGL->renderBorder(
-        fullBox, CHyprColor{(uint64_t)**PCOLORS[i]},
-        {.round = **PNATURALROUND ? sc<int>(ORIGINALROUND) : sc<int>(rounding),
-         .roundingPower = ROUNDINGPOWER,
-         .borderSize = THISBORDERSIZE,
-         .a = a,
-         .outerRound = **PNATURALROUND ? sc<int>(ORIGINALROUND) : -1});
-  }
+  fullBox.expand(-fullThickness).scale(pMonitor->m_scale).round();
 
-  // Draw vines on top of borders if enabled
-  if (**PVINETOGGLE && **PBORDERS > 0) {
-    int vineThickness = **PVINETHICKNESS > 0 ? **PVINETHICKNESS : 2;
-    CHyprColor baseVineColor = CHyprColor{(uint64_t)**PCOLORS[0]}; // Use first border color
-    
-    // Get time-appropriate color (green during day, orange after 17:00)
-    CHyprColor vineColor = getVineColorForTime(baseVineColor);
-    
-    drawVines(pMonitor, fullBox, a, vineColor, vineThickness);
+  // Lay out all rings relative to the innermost box, then shade them in one pass
+  const SBorderPPRect innerBox = {fullBox.x, fullBox.y, fullBox.width, fullBox.height};
+  std::array<SBorderRing, MAX_BORDERS> rings;
+  const size_t ringCount = layoutBorderRings({.borders = CFG.borders,
+                                              .sizes = CFG.sizes,
+                                              .colors = CFG.colors,
+                                              .scale = pMonitor->m_scale,
+                                              .rounding = rounding,
+                                              .naturalRounding = CFG.naturalRounding},
+                                             innerBox, rings);
+
+  // Skip the rings if their band (outside the rounded inner area) isn't damaged
+  if (ringCount > 0 &&
+      g_pBorderPPRenderer->isDamaged(innerBox.expanded(rings[ringCount - 1].outer), innerBox.expanded(-rounding)))
+    g_pBorderPPRenderer->drawRings(innerBox, {rings.data(), ringCount}, ROUNDINGPOWER, a);
+
+  // Vines run along the inner edge of the outermost ring
+  if (ringCount > 0)
+    fullBox.expand(rings[ringCount - 1].inner);
+
+  // Draw vines on top of borders if enabled and the tier has them
+  if (CFG.vines && m_eTier <= BPP_TIER_CACHED) {
+    const int vineThickness = CFG.vineThickness;
+
+    // Use first border color, tinted for the time of day (green during day, blending to orange around 17:00)
+    const SBorderPPColor vineColor = vineColorFor(CFG.colors[0], g_pBorderPPClock->sunset());
+    m_fLastSunset = g_pBorderPPClock->sunset();
+
+    if (m_eTier == BPP_TIER_CACHED)
+      drawVinesCached(pMonitor, fullBox, a, vineColor, vineThickness);
+    else
+      drawVines(pMonitor, fullBox, {}, a, vineColor, vineThickness, CFG.vineAnimate);
   }
 
   m_seExtents = {{fullThickness, fullThickness},
@@ -579,18 +437,6 @@ void CBordersPlusPlus::drawPass(PHLMONITOR pMonitor, const float &a) {
     m_fLastThickness = fullThickness;
     g_pDecorationPositioner->repositionDeco(this);
   }
-  
-  // Schedule periodic redraws to check for vine growth updates
-  // This ensures vines update even without window focus changes
-  static auto s_lastScheduledDamage = std::chrono::system_clock::now();
-  auto now = std::chrono::system_clock::now();
-  auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - s_lastScheduledDamage).count();
-  
-  // Request redraw every 30 seconds to check for growth changes
-  if (elapsed >= 30) {
-    damageEntire();
-    s_lastScheduledDamage = now;
-  }
 }
 
 // Returns the type of this decoration (custom type)
@@ -600,19 +446,21 @@ eDecorationType CBordersPlusPlus::getDecorationType() {
 
 // Updates the decoration when the window changes
 // Stores new window position and size, then damages the area for redraw
+// Vine paths follow moves and resizes at draw time and are not regenerated here
 void CBordersPlusPlus::updateWindow(PHLWINDOW pWindow) {
   m_lastWindowPos = pWindow->m_realPosition->value();
   m_lastWindowSize = pWindow->m_realSize->value();
 
-  // Reset vine paths when window size changes
-  m_bVinePathsGenerated = false;
-
   damageEntire();
 }
 
 // Marks the entire decoration area as damaged for redraw
 // Calculates the bounding box including borders and requests a redraw from the renderer
 void CBordersPlusPlus::damageEntire() {
+  BPP_TRACE_ZONE("damageEntire");
+
   CBox dm = m_bLastRelativeBox.copy().translate(m_lastWindowPos).expand(2);
   g_pHyprRenderer->damageBox(dm);
+
+  m_counters.add(&SBorderPPCounters::damageArea, std::max(0.0, dm.width * dm.height));
 }
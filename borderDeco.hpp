@@ -3,6 +3,23 @@
 #define WLR_USE_UNSTABLE
 
 #include <hyprland/src/render/decorations/IHyprWindowDecoration.hpp>
+#include <array>
+#include <optional>
+#include <span>
+
+#include "BorderppConfig.hpp"
+#include "BorderppRenderer.hpp"
+#include "BorderppStats.hpp"
+#include "BorderppVines.hpp"
+
+// How much of the decoration a window gets, cheapest last
+// A window rule can pin it with the tags bpp-full, bpp-cached, bpp-borders and bpp-none
+enum eBorderPPTier : uint8_t {
+  BPP_TIER_FULL = 0, // vines drawn directly every frame
+  BPP_TIER_CACHED,   // vines from the offscreen cache, redrawn only when they change
+  BPP_TIER_BORDERS,  // borders only
+  BPP_TIER_NONE,     // nothing, the window can't be seen
+};
 
 class CBordersPlusPlus : public IHyprWindowDecoration {
 public:
@@ -27,12 +44,41 @@ public:
 
   virtual std::string getDisplayName();
 
+  void onGrowthTick();
+
+  void onVinesBuilt();
+
+  void onAnimationTick(std::span<const MONITORID> dueMonitors);
+
+  const SBorderPPCounters &counters() const { return m_counters; }
+
+  eBorderPPTier tier() const { return m_eTier; }
+
 private:
-  void drawPass(PHLMONITOR, float const &a);
-  void drawVines(PHLMONITOR pMonitor, const CBox& box, const float& a, const CHyprColor& color, int thickness);
-  void generateVinePath(std::vector<Vector2D>& points, Vector2D start, Vector2D end, int segments, float curviness);
+  // Offscreen vine layer, used with the cached tier
+  // One per monitor (at a scale) the window is drawn on, like the vine views, so a
+  // window spanning monitors doesn't re-render a single layer for each of them
+  struct SVineCache {
+    std::optional<MONITORID> monitor;
+    double scale = 0;
+    uint64_t lastUse = 0;
+    CFramebuffer fb;
+    SP<CTexture> stencil;
+    float growth = -1.0f;
+    SBorderPPColor color;
+    int thickness = 0;
+    uint64_t configGeneration = 0;
+    uint64_t regenerations = 0;
+  };
+
+  void drawPass(PHLMONITOR, float const &a, const CRegion &damage);
+  CBox getMonitorLocalBox(PHLMONITOR pMonitor);
+  CBox getDrawBounds(PHLMONITOR pMonitor);
+  void drawVines(PHLMONITOR pMonitor, const CBox& box, const Vector2D& origin, const float& a, const SBorderPPColor& color, int thickness, bool animate);
+  void drawVinesCached(PHLMONITOR pMonitor, const CBox& box, const float& a, const SBorderPPColor& color, int thickness);
+  SVineCache& vineCacheFor(PHLMONITOR pMonitor);
   float getVineGrowthProgress();
-  CHyprColor getVineColorForTime(const CHyprColor& baseColor);
+  eBorderPPTier pickTier(PHLWINDOW pWindow);
 
   SBoxExtents m_seExtents;
 
@@ -47,10 +93,22 @@ private:
   double m_fLastThickness = 0;
 
   // Vine-specific properties
-  float m_fVineAnimationTime = 0.0f;
-  std::vector<std::vector<Vector2D>> m_vVinePaths;
-  bool m_bVinePathsGenerated = false;
-  float m_fLastGrowthProgress = -1.0f;
+  CBorderPPVines m_vines;
+  // Where the paths of the last m_vines.update() were drawn, to damage just the grown segments
+  PHLMONITORREF m_pVineMonitor;
+  Vector2D m_vVineOrigin;
+
+  // Offscreen vine layers, used with the cached tier
+  std::array<SVineCache, VINE_VIEW_CACHE_SIZE> m_vineCaches;
+  uint64_t m_iVineCacheClock = 0;
+  float m_fLastSunset = 0.0f;
+
+  // Quality tier of the last frame; switching keeps m_vines and the vine cache,
+  // so coming back to a higher tier doesn't lay anything out again
+  eBorderPPTier m_eTier = BPP_TIER_FULL;
+
+  // Perf counters, read by the hyprctl command
+  SBorderPPCounters m_counters;
 
   friend class CBorderPPPassElement;
 };
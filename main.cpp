@@ -1,5 +1,6 @@
 #define WLR_USE_UNSTABLE
 
+#include <sys/eventfd.h>
 #include <unistd.h>
 
 #include <any>
@@ -9,6 +10,14 @@
 #include <hyprland/src/render/Renderer.hpp>
 
 #include "borderDeco.hpp"
+#include "BorderppClock.hpp"
+#include "BorderppConfig.hpp"
+#include "BorderppPassElement.hpp"
+#include "BorderppRenderer.hpp"
+#include "BorderppStats.hpp"
+#include "BorderppTrace.hpp"
+#include "BorderppVineLibrary.hpp"
+#include "BorderppVineWorker.hpp"
 #include "globals.hpp"
 
 // Do NOT change this function.
@@ -23,6 +32,51 @@ void onNewWindow(void* self, std::any data) {
     HyprlandAPI::addWindowDecoration(PHANDLE, PWINDOW, makeUnique<CBordersPlusPlus>(PWINDOW));
 }
 
+// Written by the vine workers, read on the event loop
+static int              g_iVineBuildFd     = -1;
+static wl_event_source* g_pVineBuildSource = nullptr;
+// Writes newly generated vine shapes to the cache once layouts have settled
+static wl_event_source* g_pVineCacheTimer = nullptr;
+constexpr int           VINE_CACHE_SAVE_DELAY_MS = 5000;
+
+static int onVineCacheTimer(void* data) {
+    g_borderPPVineLibrary.save();
+    return 0;
+}
+
+// A background vine layout finished; its decoration is damaged so the next frame swaps it in
+static int onVinesBuilt(int fd, uint32_t mask, void* data) {
+    uint64_t count = 0;
+    (void)read(fd, &count, sizeof(count));
+
+    // every batch of layouts pushes the write back, so a burst of them writes once
+    if (g_borderPPVineLibrary.dirty())
+        wl_event_source_timer_update(g_pVineCacheTimer, VINE_CACHE_SAVE_DELAY_MS);
+
+    for (auto const& w : g_pCompositor->m_windows) {
+        for (auto const& deco : w->m_windowDecorations) {
+            if (const auto PDECO = dynamic_cast<CBordersPlusPlus*>(deco.get()))
+                PDECO->onVinesBuilt();
+        }
+    }
+
+    return 0;
+}
+
+#ifdef BORDERPP_TRACE
+// `hyprctl bpptrace [path]` writes the buffered trace zones out as Chrome trace JSON
+static std::string onTraceCommand(eHyprCtlOutputFormat format, std::string request) {
+    const auto SPACE = request.find(' ');
+    const auto PATH  = SPACE == std::string::npos ? borderPPTraceDefaultPath() : request.substr(SPACE + 1);
+    const int  COUNT = borderPPTraceFlush(PATH);
+
+    if (COUNT < 0)
+        return std::format("error: can't write {}\n", PATH);
+
+    return std::format("wrote {} zones to {}\n", COUNT, PATH);
+}
+#endif
+
 APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
     PHANDLE = handle;
 
@@ -34,19 +88,43 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
         throw std::runtime_error("[bpp] Version mismatch");
     }
 
-    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:add_borders", Hyprlang::INT{1});
-    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:natural_rounding", Hyprlang::INT{1});
-    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:enable_vines", Hyprlang::INT{1});
-    HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:vine_thickness", Hyprlang::INT{2});
-
-    for (size_t i = 0; i < 9; ++i) {
-        HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:col.border_" + std::to_string(i + 1), Hyprlang::INT{*configStringToInt("rgba(000000ee)")});
-        HyprlandAPI::addConfigValue(PHANDLE, "plugin:borders-plus-plus:border_size_" + std::to_string(i + 1), Hyprlang::INT{-1});
-    }
+    g_pBorderPPConfig = makeUnique<CBorderPPConfig>();
 
     HyprlandAPI::reloadConfig();
+    g_pBorderPPConfig->reload();
+
+    g_pBorderPPClock = makeUnique<CBorderPPClock>();
+
+    // strand shapes generated by an earlier run (or before a reload) are mapped in, not generated again
+    g_borderPPVineLibrary.open(vineCachePath());
+
+    g_pVineCacheTimer = wl_event_loop_add_timer(g_pCompositor->m_wlEventLoop, ::onVineCacheTimer, nullptr);
+
+    // vines are laid out off the render thread, which keeps drawing the old layout meanwhile
+    g_iVineBuildFd     = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    g_pVineBuildSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, g_iVineBuildFd, WL_EVENT_READABLE, ::onVinesBuilt, nullptr);
+    g_pBorderPPVineWorker = std::make_unique<CBorderPPVineWorker>(0, [] {
+        const uint64_t ONE = 1;
+        (void)write(g_iVineBuildFd, &ONE, sizeof(ONE));
+    });
 
     static auto P = HyprlandAPI::registerCallbackDynamic(PHANDLE, "openWindow", [&](void* self, SCallbackInfo& info, std::any data) { onNewWindow(self, data); });
+    static auto P2 = HyprlandAPI::registerCallbackDynamic(PHANDLE, "configReloaded", [&](void* self, SCallbackInfo& info, std::any data) {
+        g_pBorderPPConfig->reload();
+        g_pBorderPPClock->reload();
+    });
+    static auto P3 = HyprlandAPI::registerCallbackDynamic(PHANDLE, "render", [&](void* self, SCallbackInfo& info, std::any data) {
+        // per-frame scratch memory is released before each monitor renders
+        if (std::any_cast<eRenderStage>(data) == RENDER_PRE && g_pBorderPPRenderer)
+            g_pBorderPPRenderer->beginFrame();
+    });
+
+    // `hyprctl bppstats` prints the perf counters as JSON
+    static auto STATS = HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "bppstats", .exact = true, .fn = [](eHyprCtlOutputFormat, std::string) { return borderPPStatsJson(); }});
+
+#ifdef BORDERPP_TRACE
+    static auto TRACE = HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "bpptrace", .exact = false, .fn = onTraceCommand});
+#endif
 
     // add deco to existing windows
     for (auto& w : g_pCompositor->m_windows) {
@@ -62,5 +140,21 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
 }
 
 APICALL EXPORT void PLUGIN_EXIT() {
+    // joins the workers, so nothing writes to the eventfd after it is closed
+    g_pBorderPPVineWorker.reset();
+    if (g_pVineBuildSource)
+        wl_event_source_remove(g_pVineBuildSource);
+    close(g_iVineBuildFd);
+
+    // whatever the debounce hasn't written yet, so a reload finds it
+    if (g_pVineCacheTimer)
+        wl_event_source_remove(g_pVineCacheTimer);
+    g_borderPPVineLibrary.save();
+
     g_pHyprRenderer->m_renderPass.removeAllOfType("CBorderPPPassElement");
+
+    g_pHyprRenderer->makeEGLCurrent();
+    g_pBorderPPRenderer.reset();
+    g_pBorderPPConfig.reset();
+    g_pBorderPPClock.reset();
 }